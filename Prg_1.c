@@ -7,14 +7,54 @@
  *  and writes the process data into a file.
  *
  *  To use this program, make sure you have src.txt and data.txt in your folder
- *  To compile this file - write in the terminal : gcc -o Prg_1 Prg_1.c -lpthread -lrt
+ *  To compile this file - write in the terminal : gcc -o Prg_1 Prg_1.c -lpthread -lrt -lm
  *  then write in the terminal: ./Prg_1 4 output.txt
  *
+ *  To compare time quanta, give a range (first:last[:step]) or a list (4,8,16) instead of the time quantum:
+ *  ./Prg_1 -p rr,mlfq 1:100 sweep.txt runs every policy with every quantum on a pool of threads, one per CPU core,
+ *  and writes a table of the average wait and turnaround times, context switches, switch overhead and throughput.
+ *  -o, -T, -e, -g, -r and -c are for one schedule and cannot be used with a sweep.
+ *
+ *  Options (placed before the time quantum):
+ *    -p policy  scheduling policy to run: rr (default), rr-tick, fcfs, sjf, srtf, priority or mlfq - a comma separated
+ *               list of policies when sweeping
+ *    -t  same as -p rr-tick - run the original tick-by-tick round robin loop instead of the event-driven engine
+ *    -a interval  priority policy only - a waiting process gains one priority level every interval time units
+ *    -i workload  read the processes from a workload file instead of asking for them. The file is either text with
+ *                 one "arrive time, burst time[, priority]" line per process (# starts a comment) or the binary
+ *                 format in Prg_1.h
+ *    -m  rr only, with -i - read the workload file a chunk at a time while the schedule runs instead of loading it
+ *        first, so the memory used depends on the number of processes waiting at once rather than the length of the
+ *        file. The file must be sorted by arrive time. Use -r to write the results of every process.
+ *    -w workload.bin  save the processes in the binary workload format before they are scheduled
+ *    -o results.bin  save the results of every process in the binary results format in Prg_1.h once the schedule
+ *                    has run - one column per field, read with ./Prg_1_results results.bin
+ *    -g  write every dispatch, preemption and completion to the output file while the schedule runs
+ *    -r  write the wait time and turnaround time of every process to the output file as it completes
+ *    -T  print how long each stage of the run took - loading, sorting, scheduling, sending the results to thread 2
+ *        and writing the file - and how long each thread waited on the semaphores, when the run ends
+ *    -e  rr only - also run the schedule on real threads, one per process doing CPU work for its burst with each time
+ *        unit taken as a millisecond, and write the measured wait and turnaround times next to the simulated ones
+ *        with the dispatch and preemption latencies. Uses SCHED_FIFO and CPU affinity where permitted. The simulated
+ *        times have no switch cost or dispatch latency to compare with, so -e cannot be used with -s or -d.
+ *    -s cost  time taken to switch the CPU from one process to another, 0 by default (every policy but rr-tick)
+ *    -d latency  time taken by the dispatcher every time it starts a process, 0 by default (every policy but rr-tick)
+ *    -c cores  round robin only - simulate this many CPUs, each taking the next process when it is free
+ *    -b global|steal  with -c - the cores share one run queue (default) or each has its own and takes processes
+ *                     from the others when it runs out
+ *    -x ring|fifo|shm|export  how the results are passed to the thread that writes the file: a ring in memory that
+ *                  both threads use at the same time (default), the named FIFO, or the same ring in POSIX shared
+ *                  memory. With export there is no second thread - the output file argument is instead the name of
+ *                  the shared memory, and a separate process reads it: ./Prg_1_report /name output.txt
+ *                  The reporter writes what -g and -r ask for, and removes the name when it attaches. If no reporter
+ *                  has read the results 10 seconds after the schedule ends, Prg_1 removes the name itself.
+ *
  *  @author Jeremy Yiu
  *  @date 2017-05-27
  *
  */
 
+#define _GNU_SOURCE /* CPU affinity of the threads of -e */
 #include <stdio.h>
 #include <sys/types.h>
 #include <unistd.h>
@@ -24,10 +64,41 @@
 #include <ctype.h>
 #include <fcntl.h>
 #include <sys/stat.h>
+#include <sys/mman.h>
+#include <stdint.h>
+#include <limits.h>
+#include <math.h>
+#include <time.h>
+#include <stdatomic.h>
 #include <pthread.h>  /* required for pthreads */
+#include <sched.h>
+#if defined(__x86_64__) || defined(__i386__)
+#include <immintrin.h> /* SSE4.1 and AVX2 kernels of summariseResults */
+#endif
 #include <semaphore.h> /* required for semaphores */
 #include "Prg_1.h"
 
+/* every policy that can be chosen with -p */
+const struct_policy policies[] = {
+	{"rr", scheduleRoundRobin, 0, 1, "round robin, run from event to event"},
+	{"rr-tick", scheduleRoundRobinTicks, 0, 1, "round robin, run one time unit at a time"},
+	{"fcfs", firstComeFirstServed, 0, 0, "first come first served"},
+	{"sjf", shortestJobFirst, 0, 0, "shortest job first, non-preemptive"},
+	{"srtf", shortestRemainingTimeFirst, 0, 0, "shortest remaining time first, preemptive"},
+	{"priority", priorityScheduling, 1, 0, "lowest priority number first, non-preemptive, with aging (-a)"},
+	{"mlfq", multilevelFeedbackQueue, 0, 1, "multilevel feedback queue, the quantum doubles on each lower level"},
+	{NULL, NULL, 0, 0, NULL}
+};
+
+const struct_result_kernel resultKernels[] = {
+#if defined(__x86_64__) || defined(__i386__)
+	{"avx2", summariseResultsAVX2, resultKernelAVX2Supported},
+	{"sse4.1", summariseResultsSSE41, resultKernelSSE41Supported},
+#endif
+	{"scalar", summariseResultsScalar, resultKernelAlwaysSupported},
+	{NULL, NULL, NULL}
+};
+
 /* *************************** User Instructions *******************************/
 void instructions(void)
 {
@@ -36,33 +107,205 @@ void instructions(void)
 	printf("           *************************** Program Instructions ***************************\n");
 	printf("           ****************** RTOS Assignment 3a by Jeremy Yiu 11656206 ***************\n");
 	printf("           *********** To compile this file - write in the terminal :- ****************\n");
-	printf("           ***************** gcc -o Prg_1 Prg_1.c -lpthread -lrt **********************\n");
+	printf("           *************** gcc -o Prg_1 Prg_1.c -lpthread -lrt -lm ********************\n");
 	printf("           ************* then write in the terminal:  ./Prg_1 4 output.txt ************\n");
 	printf("           ****************************************************************************\n\n");
 
 }
+
+void usage(void)
+{
+	int index;
+	printf("usage: ./Prg_1 [-p policy] [-t] [-a interval] [-i workload [-m]] [-w workload.bin] [-o results.bin] [-g] [-r] [-T] [-e] [-s cost] [-d latency] [-c cores] [-b global|steal] [-x ring|fifo|shm|export] 4 output.txt \n");
+	printf("       ./Prg_1 [-p policy,policy...] [options] first:last[:step] output.txt - sweep a range of time quanta\n");
+	printf("       ./Prg_1 [-p policy,policy...] [options] 4,8,16 output.txt - sweep a list of time quanta\n");
+	printf("policies:\n");
+	for (index = 0; policies[index].name != NULL; index++)
+		printf("  %-9s %s\n", policies[index].name, policies[index].description);
+}
 /* ************************* End of User Instructions ***************************** */
 
 
 
 
 /* ************************ Main Thread  **************************** */
-
+#ifndef PRG_1_NO_MAIN //the benchmark program provides its own main
 int main(int argc, char* argv[])
 {
 	FILE *fp; //file pointer
 	int timeQuantum;
-	int fifofd; //fifo file descriptor
+	int fifoWriteFd, fifoReadFd; //fifo file descriptors of the two threads
+	struct_ring *ring = NULL; //shared by the two threads unless the FIFO is used
+	int opt;
 	pthread_t thread1, thread2;    /* pthread defintions */
 	sem_t sem_read, sem_write; /* semaphore definitions */
+	struct_options options = {NULL}; //round robin unless -p or -t is given
+	struct_process_info *processes = NULL; //processes read from a workload file
+	int numOfProcesses = 0;
+	char *policyNames = "rr";
+	char shmName[32]; //name of the shared memory of -x shm
+	struct_timing timing; //where the time went, reported with -T
+	char report[2048];
 
+	initialiseTiming(&timing);
 	instructions();	//print instructions
 	remove(FIFONAME); //Ensure that the FIFO file doesn't exist when next created.
 
+	while ((opt = getopt(argc, argv, "tp:a:i:mw:o:grx:c:b:s:d:Te")) != -1) //read the options placed before the time quantum
+	{
+		switch (opt)
+		{
+		case 't':
+			policyNames = "rr-tick"; //use the original tick-by-tick loop
+			break;
+		case 'p':
+			policyNames = optarg; //checked once we know whether this is a sweep
+			break;
+		case 'a':
+			if (isPositiveNumber(optarg) != 0)
+			{
+				printf("The aging interval must be a positive integer \n");
+				return -1;
+			}
+			options.agingInterval = atoi(optarg);
+			break;
+		case 'i':
+			options.inputFile = optarg; //read the processes from a file
+			break;
+		case 'w':
+			options.binaryFile = optarg; //save the processes as a binary workload
+			break;
+		case 'o':
+			options.resultsFile = optarg; //save the results of every process in the binary results format
+			break;
+		case 'g':
+			options.traceSchedule = 1; //stream the schedule into the output file
+			break;
+		case 'm':
+			options.streamInput = 1; //read the workload while the schedule runs
+			break;
+		case 'r':
+			options.processResults = 1; //stream the result of every process into the output file
+			break;
+		case 'T':
+			options.timing = &timing; //report the time taken by each stage of the run
+			break;
+		case 'e':
+			options.execute = 1; //run the schedule on real threads as well
+			break;
+		case 's':
+		case 'd':
+			if (isPositiveNumber(optarg) != 0)
+			{
+				printf("The switch cost and dispatch latency must be non-negative integers \n");
+				return -1;
+			}
+			if (opt == 's')
+				options.switchCost = atoi(optarg);
+			else
+				options.dispatchLatency = atoi(optarg);
+			break;
+		case 'c':
+			if (isPositiveNumber(optarg) != 0 || atoi(optarg) < 1)
+			{
+				printf("The number of cores must be a positive integer \n");
+				return -1;
+			}
+			options.numOfCores = atoi(optarg);
+			break;
+		case 'b':
+			if (strcmp(optarg, "global") == 0)
+				options.balancing = BALANCE_GLOBAL;
+			else if (strcmp(optarg, "steal") == 0)
+				options.balancing = BALANCE_STEAL;
+			else
+			{
+				printf("Unknown balancing: %s\n", optarg);
+				usage();
+				return -1;
+			}
+			break;
+		case 'x':
+			if (strcmp(optarg, "ring") == 0)
+				options.transport = TRANSPORT_RING;
+			else if (strcmp(optarg, "fifo") == 0)
+				options.transport = TRANSPORT_FIFO;
+			else if (strcmp(optarg, "shm") == 0)
+				options.transport = TRANSPORT_SHM;
+			else if (strcmp(optarg, "export") == 0)
+				options.transport = TRANSPORT_EXPORT;
+			else
+			{
+				printf("Unknown transport: %s\n", optarg);
+				usage();
+				return -1;
+			}
+			break;
+		default:
+			usage();
+			return -1;
+		}
+	}
+	argc -= optind - 1; //drop the options so that the time quantum is argv[1] and the file is argv[2]
+	argv += optind - 1;
+
 	if (argc != 3) //check if there are enough arguments placed
 	{
 		printf("Not enough arguments placed in command line \n");
-		printf("usage: ./Prg_1 4 output.txt \n");
+		usage();
+		return -1;
+	}
+
+	if (options.streamInput && (options.inputFile == NULL || options.binaryFile != NULL || options.numOfCores > 1))
+	{
+		printf("-m streams the workload file given with -i into one round robin CPU, and cannot be used with -w or -c\n");
+		return -1;
+	}
+	if (options.streamInput && options.resultsFile != NULL)
+	{
+		printf("-m drops each process as it completes, so its results cannot be saved with -o\n");
+		return -1;
+	}
+	if (strchr(argv[1], ':') != NULL || strchr(argv[1], ',') != NULL) //a range or list of time quanta to sweep
+	{
+		if (options.streamInput)
+		{
+			printf("A sweep runs every simulation on the whole workload, so it cannot be streamed with -m\n");
+			return -1;
+		}
+		if (options.resultsFile != NULL || options.timing != NULL || options.execute || options.traceSchedule ||
+		        options.processResults || options.numOfCores > 0)
+		{
+			printf("-o, -T, -e, -g, -r and -c are for one schedule, so they cannot be used with a sweep\n");
+			return -1;
+		}
+		return sweepMain(argv[1], argv[2], policyNames, &options);
+	}
+
+	if ((options.policy = findPolicy(policyNames)) == NULL)
+	{
+		printf("Unknown policy: %s\n", policyNames);
+		usage();
+		return -1;
+	}
+	if (options.numOfCores > 1 && options.policy->run != scheduleRoundRobin)
+	{
+		printf("Only the rr policy can be run on more than one core\n");
+		return -1;
+	}
+	if (options.streamInput && options.policy->run != scheduleRoundRobin)
+	{
+		printf("Only the rr policy can be run on a streamed workload\n");
+		return -1;
+	}
+	if (options.execute && (options.policy->run != scheduleRoundRobin || options.numOfCores > 1 || options.streamInput))
+	{
+		printf("-e runs the rr policy on one CPU with the whole workload, so it cannot be used with -p, -c or -m\n");
+		return -1;
+	}
+	if (options.execute && (options.switchCost != 0 || options.dispatchLatency != 0))
+	{
+		printf("-e measures the real switch and dispatch times, so it cannot be used with -s or -d\n");
 		return -1;
 	}
 
@@ -74,33 +317,76 @@ int main(int argc, char* argv[])
 	}
 	timeQuantum = atoi(argv[1]); //set timequantum to integer given by the user
 
-	fp = fopen(argv[2], "w"); //open the file to write
-	if (!fp) //if unable to open print error and exit the program
+	beginStage(options.timing, STAGE_LOAD);
+	if (options.inputFile != NULL && !options.streamInput && loadWorkload(options.inputFile, &processes, &numOfProcesses) != 0) //read the workload file
+		return (-1);
+	endStage(options.timing, STAGE_LOAD);
+
+	fp = NULL;
+	if (options.transport != TRANSPORT_EXPORT && (fp = fopen(argv[2], "w")) == NULL) //open the file to write
 	{
-		perror("Error opening file");
+		perror("Error opening file"); //if unable to open print error and exit the program
 		return (-1);
 	}
 
 	initialiseSemaphores(&sem_write, &sem_read);  //initailise semaphores so that they can used in the threads
+	if (options.transport == TRANSPORT_RING && (ring = ConstructRing(RING_BYTES)) == NULL)
+	{
+		perror("ConstructRing");
+		return (-1);
+	}
+	if (options.transport == TRANSPORT_SHM) //a name no other run uses, removed as soon as it is mapped so nothing is left behind
+	{
+		snprintf(shmName, sizeof shmName, "/Prg_1.%d", (int) getpid());
+		if ((ring = CreateSharedRing(shmName, RING_BYTES, 0)) == NULL)
+			return (-1);
+		shm_unlink(shmName);
+	}
+	if (options.transport == TRANSPORT_EXPORT) //the reporting process removes the name once it has attached
+	{
+		if ((ring = CreateSharedRing(argv[2], RING_BYTES, (options.traceSchedule ? RING_TRACE_SCHEDULE : 0) |
+		                             (options.processResults ? RING_PROCESS_RESULTS : 0))) == NULL)
+			return (-1);
+		printf("Results are written to shared memory %s - read them with: ./Prg_1_report %s output.txt\n", argv[2], argv[2]);
+	}
 	/* put values into structs so that they can be passed to the threads */
-	struct_thread1_info a = {&sem_write, &sem_read, timeQuantum, &fifofd};
-	struct_thread2_info b = {&sem_read, &sem_write, fp, &fifofd};
+	struct_thread1_info a = {&sem_write, &sem_read, timeQuantum, &fifoWriteFd, ring, &options, processes, numOfProcesses};
+	struct_thread2_info b = {&sem_read, &sem_write, fp, &fifoReadFd, ring, &options};
 
 	/* create new threads */
 	if (pthread_create(&thread1, NULL, (void *)thread1_routine, &a) != 0 ||
-	        pthread_create(&thread2, NULL, (void *)thread2_routine, &b) != 0)
+	        (options.transport != TRANSPORT_EXPORT && pthread_create(&thread2, NULL, (void *)thread2_routine, &b) != 0))
 	{
 		perror("pthread_create"); //if unable to create threads, print error and exit program
 		return (-1);
 	}
 
 	pthread_join(thread1, NULL); /* to identify if the thread-termination was completed */
-	pthread_join(thread2, NULL);
+	if (options.transport != TRANSPORT_EXPORT)
+		pthread_join(thread2, NULL);
 
 	unlink(FIFONAME); //deletes name from file system
-	fclose(fp); //close file
+	if (options.transport == TRANSPORT_RING)
+		DestructRing(ring);
+	else if (ring != NULL) //the reporting process may still be reading its own mapping of the ring
+	{
+		if (options.transport == TRANSPORT_EXPORT && ReleaseSharedRing(ring, argv[2]) != 0)
+			printf("No reporting process read the results in %s, so it has been removed\n", argv[2]);
+		DetachSharedRing(ring);
+	}
+	beginStage(options.timing, STAGE_CLOSE);
+	if (fp != NULL)
+		fclose(fp); //close file
+	endStage(options.timing, STAGE_CLOSE);
+	free(processes);
+	if (options.timing != NULL)
+	{
+		formatTiming(report, sizeof report, options.timing);
+		printf("\n%s", report);
+	}
 	return 0;
 }
+#endif
 
 
 /* ************************ End of Main Thread  **************************** */
@@ -114,64 +400,188 @@ int main(int argc, char* argv[])
 
 void *thread1_routine(struct_thread1_info * data)
 {
-	sem_wait(data->sem_write_fifo); /* wait until read pipe is available */
+	struct_timing *timing = data->options->timing; //NULL unless the run is timed with -T
 
-	int numOfProcesses, i;
-	do {
-		printf("Enter number of processes ");
-	}
-	while (getNumber(&numOfProcesses) != 0); //get number of processes - number must be a non-negative integer
+	waitSemaphore(data->sem_write_fifo, timing, THREAD_1); /* wait until read pipe is available */
 
-	struct_process_info processes[numOfProcesses];
-	initialiseProcesses(processes, numOfProcesses); //get process data - how many processes, arrival times and burst time
-	printProcesses(processes, numOfProcesses, data->timeQuantum); //print process data
+	int numOfProcesses = 0, i;
+	struct_process_info *processes = data->processes;
+	struct_workload_stream *stream = NULL;
+
+	beginStage(timing, STAGE_INPUT);
+	if (data->options->streamInput) //the processes are read while the schedule runs
+	{
+		if ((stream = openWorkloadStream(data->options->inputFile)) == NULL)
+			exit(1);
+		printf("Streaming processes from %s, Time quantum: %d\n\n", data->options->inputFile, data->timeQuantum);
+	}
+	else if (processes != NULL) //the processes were read from a workload file
+	{
+		numOfProcesses = data->numOfProcesses;
+		printf("Read %d processes from %s, Time quantum: %d\n\n", numOfProcesses, data->options->inputFile, data->timeQuantum);
+	}
+	else
+	{
+		processes = askForProcesses(&numOfProcesses, data->options->policy->usesPriority); //get process data from the user
+		printProcesses(processes, numOfProcesses, data->timeQuantum); //print process data
+	}
+	endStage(timing, STAGE_INPUT);
 
-	/*** Round Robin ***/
-	sortByArrivalTimes(processes, numOfProcesses); //sort the processes according to arrival times in ascending order
-	roundRobin(processes, numOfProcesses, data->timeQuantum); //run round robin algorithm
+	if (data->options->binaryFile != NULL && stream == NULL) //save the processes so that they can be read back faster with -i
+	{
+		beginStage(timing, STAGE_SAVE_WORKLOAD);
+		if (saveWorkloadBinary(data->options->binaryFile, processes, numOfProcesses) != 0)
+			printf("The processes were not saved to %s\n", data->options->binaryFile);
+		endStage(timing, STAGE_SAVE_WORKLOAD);
+	}
 
-	double avgWaitTime = averageWaitTime(processes, numOfProcesses); //calculate average wait time
-	double avgTurnAroundTime = averageTurnAroundTime(processes, numOfProcesses); //calculate average turnaround time
+	/*** Scheduling ***/
+	struct_sim_stats *stats = (struct_sim_stats*) malloc(sizeof (struct_sim_stats)); //filled in as each process completes
+	if (stats == NULL)
+	{
+		perror("malloc");
+		exit(1);
+	}
+	initialiseStats(stats);
 
-	char string[80]; //string used to store average wait time and turnaround time
+	/* the reader is started before the schedule runs so that it can write the results while they are produced */
+	if (data->ring == NULL) //thread 2 is already reading the ring, but it waits for the FIFO to be created
+	{
+		beginStage(timing, STAGE_FIFO_SETUP);
+		initialiseFifo();
+		sem_post(data->sem_read_fifo); /* relinquish access to read sem */
+		if ((*data->fifofd = open(FIFONAME, O_WRONLY)) < 0) //open the FIFO as write only - waits until thread 2 opens it to read
+		{
+			perror("open");
+			exit(1);
+		}
+		endStage(timing, STAGE_FIFO_SETUP);
+	}
 
-	initialiseFifo();
-	sprintf(string, "Average Wait Time: %lf \nAverage Turnaround Time: %lf \n", avgWaitTime, avgTurnAroundTime);
-	//can put a fuction that can either open via read only or write only and get FIFONAME from parameter and open FIFO file descriptor
-	if (*data->fifofd = open(FIFONAME, O_WRONLY) < 0) //open the FIFO as write only
+	struct_frame_writer *frames = (struct_frame_writer*) malloc(sizeof (struct_frame_writer)); //batches trace events
+	if (frames == NULL)
 	{
-		perror("open");
+		perror("malloc");
 		exit(1);
 	}
-	write(*data->fifofd, string, strlen(string)); //write string to FIFO
-	close(*data->fifofd); //close FIFO
+	initialiseFrameWriter(frames, *data->fifofd, data->ring, data->options->traceSchedule);
+	frames->timing = timing;
+	struct_sim_config config = {
+		.timeQuantum = data->timeQuantum,
+		.agingInterval = data->options->agingInterval,
+		.stats = stats,
+		.traceContext = frames,
+		.switchCost = data->options->switchCost,
+		.dispatchLatency = data->options->dispatchLatency
+	};
+	if (data->options->traceSchedule || data->options->processResults)
+		config.trace = traceToFrames;
+	if (stream == NULL)
+	{
+		beginStage(timing, STAGE_SORT);
+		if (sortByArrivalTimes(processes, numOfProcesses) != 0) //sort the processes according to arrival times in ascending order
+		{
+			perror("malloc");
+			exit(1);
+		}
+		endStage(timing, STAGE_SORT);
+	}
+	beginStage(timing, STAGE_SCHEDULE);
+	if (stream != NULL) //the file is already sorted, only the processes that are waiting are held in memory
+	{
+		if (scheduleRoundRobinStream(stream, &config) != 0)
+			printf("Stopped reading %s - the results are for the processes completed before the error\n", data->options->inputFile);
+		closeWorkloadStream(stream);
+	}
+	else if (data->options->numOfCores > 1) //round robin on several CPUs
+	{
+		config.numOfCores = stats->numOfCores = data->options->numOfCores;
+		config.balancing = data->options->balancing;
+		config.coreStats = (struct_core_stats*) malloc(sizeof (struct_core_stats) * config.numOfCores);
+		if (config.coreStats == NULL)
+		{
+			perror("malloc");
+			exit(1);
+		}
+		scheduleMultiCore(processes, numOfProcesses, &config);
+	}
+	else
+		data->options->policy->run(processes, numOfProcesses, &config); //run the chosen scheduling policy
+	flushFrame(frames); //write the last batch of trace events
+	endStage(timing, STAGE_SCHEDULE);
+	if (data->options->resultsFile != NULL)
+	{
+		beginStage(timing, STAGE_SAVE_RESULTS);
+		if (saveResultsBinary(data->options->resultsFile, processes, numOfProcesses) == 0)
+			printf("Results of %d processes saved to %s\n", numOfProcesses, data->options->resultsFile);
+		endStage(timing, STAGE_SAVE_RESULTS);
+	}
+
+	char string[MSGLENGTH]; //string used to store the averages, percentiles, throughput and utilisation
 
-	sem_post(data->sem_read_fifo); /* relinquish access to read sem */
+	beginStage(timing, STAGE_REPORT);
+	formatStats(string, sizeof string, stats);
+	writeFrame(frames, FRAME_SUMMARY, string, strlen(string)); //write string to FIFO
+	if (config.coreStats != NULL) //one line per core, as many as fit in each frame
+	{
+		size_t used = 0;
+		char text[FRAME_BATCH_BYTES - sizeof (struct_frame_header)];
+		for (i = 0; i < config.numOfCores; i++)
+		{
+			if (used + MSGLENGTH > sizeof text)
+			{
+				writeFrame(frames, FRAME_TEXT, text, used);
+				used = 0;
+			}
+			used += formatCoreStats(text + used, sizeof text - used, &config.coreStats[i], i, stats);
+		}
+		writeFrame(frames, FRAME_TEXT, text, used);
+		free(config.coreStats);
+	}
+	if (data->options->execute) //run the same schedule on threads and send both results
+		executeAndReport(frames, processes, numOfProcesses, data->timeQuantum);
+	free(stats);
+	free(frames);
+	if (data->ring != NULL) //thread 2 reads until it sees the end of the ring or FIFO
+		RingClose(data->ring);
+	else
+		close(*data->fifofd); //close FIFO
+	endStage(timing, STAGE_REPORT);
 
+	if (processes != data->processes) //free the processes entered by the user
+		free(processes);
+	return NULL;
 }
 
 void *thread2_routine(struct_thread2_info * data)
 {
-	sem_wait(data->sem_read_fifo); /* wait until read pipe is available */
 	int n;
-	char datafromFIFO[MSGLENGTH];
 
-	if (*data->fifofd = open(FIFONAME,  O_RDONLY | O_NONBLOCK) < 0) //open the FIFO as read only and does not wait for write
+	beginStage(data->options->timing, STAGE_WRITE_FILE);
+	if (data->ring != NULL) //the ring exists from the start, so it is read while thread 1 asks for the processes and runs the schedule
+	{
+		n = readFrames(-1, data->ring, data->fp, data->options); //write every frame from the ring into the file until thread 1 closes it
+		if (n == 0)
+			printf("Ring is empty.\n");
+		endStage(data->options->timing, STAGE_WRITE_FILE);
+		return NULL;
+	}
+
+	waitSemaphore(data->sem_read_fifo, data->options->timing, THREAD_2); /* wait until read pipe is available */
+	if ((*data->fifofd = open(FIFONAME, O_RDONLY)) < 0) //open the FIFO as read only - waits until thread 1 opens it to write
 	{
 		perror("open");
 		exit(1);
 	}
-	n = read(*data->fifofd, datafromFIFO, MSGLENGTH); //get data from FIFO
+	n = readFrames(*data->fifofd, NULL, data->fp, data->options); //write every frame from the FIFO into the file until thread 1 closes it
 
 	if (n == 0) //nothing in the FIFO
 		printf("FIFO is empty.\n");
-	else
-	{
-		writeToFile(data->fp, datafromFIFO); //write data from the FIFO and write it to the file
-	}
 	/* close the FIFO */
 	close(*data->fifofd);
 	sem_post(data->sem_write_fifo); /* relinquish access to write pipe */
+	endStage(data->options->timing, STAGE_WRITE_FILE);
+	return NULL;
 }
 
 /* ************************ End of methods and functions for using multi-threading **************************** */
@@ -200,7 +610,7 @@ void initialiseFifo(void)
 		exit(1);
 	}
 
-	if (fifofd = open(FIFONAME,  O_RDONLY | O_NONBLOCK) < 0) //ensure that the fifo file is properly created and make it read only and non-blocking
+	if ((fifofd = open(FIFONAME,  O_RDONLY | O_NONBLOCK)) < 0) //ensure that the fifo file is properly created and make it read only and non-blocking
 	{
 		perror("open");
 		exit(1);
@@ -215,180 +625,3796 @@ void initialiseFifo(void)
 
 
 
-/* ************************ Methods and functions for read/writing to files **************************** */
-int writeToFile(FILE *f, char *buffer)
+/* ************************ Methods and functions for timing a run **************************** */
+/*
+ * @brief - initialiseTiming - starts the clock of a run, with every stage marked as not run
+ */
+void initialiseTiming(struct_timing *timing)
 {
-	fputs(buffer, f); /*put contents of the buffer into the file  */
-	printf("Content written to file:-\n%s", buffer);
-	return 0;
-}
+	int stage;
 
-/* ************************ End of Methods and functions for read/writing to files **************************** */
+	memset(timing, 0, sizeof (struct_timing));
+	for (stage = 0; stage < STAGES; stage++)
+		timing->stageStart[stage] = -1;
+	clock_gettime(CLOCK_MONOTONIC, &timing->start);
+}
 
+/*
+ * @brief - nanosecondsSince - wall-clock time from start until now
+ */
+long long nanosecondsSince(const struct timespec *start)
+{
+	struct timespec now;
 
+	clock_gettime(CLOCK_MONOTONIC, &now);
+	return (now.tv_sec - start->tv_sec) * 1000000000LL + (now.tv_nsec - start->tv_nsec);
+}
 
+/*
+ * @brief - beginStage - records when a stage starts - does nothing when the run is not timed
+ */
+void beginStage(struct_timing *timing, int stage)
+{
+	if (timing != NULL)
+		timing->stageStart[stage] = nanosecondsSince(&timing->start);
+}
 
+/*
+ * @brief - endStage - records how long a stage took since beginStage - does nothing when the run is not timed
+ */
+void endStage(struct_timing *timing, int stage)
+{
+	if (timing != NULL)
+		timing->stageTime[stage] = nanosecondsSince(&timing->start) - timing->stageStart[stage];
+}
 
-/* ************************ Methods for handling process data **************************** */
+/*
+ * @brief - waitSemaphore - sem_wait that adds the time spent waiting to the semaphore wait of a thread
+ */
+void waitSemaphore(sem_t *semaphore, struct_timing *timing, int thread)
+{
+	struct timespec start;
 
+	if (timing != NULL)
+		clock_gettime(CLOCK_MONOTONIC, &start);
+	while (sem_wait(semaphore) == -1 && errno == EINTR)
+		;
+	if (timing != NULL)
+		timing->semaphoreWait[thread] += nanosecondsSince(&start);
+}
 
-void initialiseProcesses(struct_process_info *processes, int arraySize)
+/*
+ * @brief - formatTiming - writes the report of -T: when each stage started and how long it took, in milliseconds
+ *
+ * The stages of the two threads overlap, so their durations add up to more than the total. The time thread 1 spent
+ * sending frames is part of its schedule stage, and the time thread 2 spent receiving them is part of its write stage.
+ * Returns the number of characters written, like snprintf.
+ */
+int formatTiming(char *buffer, size_t length, const struct_timing *timing)
 {
-	int index;
-	for (index = 0; index < arraySize; index++)
-	{
-		processes[index].processId = index + 1;
-		processes[index].waitTime = 0;
-		printf("Process[%d]: What is the arrive Time? ", processes[index].processId); //get arrive time of the process from the user
-		getNumber(&processes[index].arriveTime);
-
-		printf("Process[%d]: What is the burst Time? ", processes[index].processId); //get burst time from the user
-		getNumber(&processes[index].burstTime);
+	static const char *names[STAGES] = {"load workload", "input", "save workload", "FIFO setup", "sort", "schedule",
+	                                    "save results", "report", "write file", "close file"};
+	static const char *threads[STAGES] = {"main", "thread 1", "thread 1", "thread 1", "thread 1", "thread 1",
+	                                      "thread 1", "thread 1", "thread 2", "main"};
+	size_t used;
+	int stage;
 
-		processes[index].remainingTime = processes[index].burstTime; //set remainingtime to the burst time
-		processes[index].turnAroundTime = 0; //set turnaround time and wait time as 0 so that they are initalised.
-		processes[index].waitTime = 0;
-		puts("");
-	}
+	used = snprintf(buffer, length, "Timing (ms)          thread         start      duration \n");
+	for (stage = 0; stage < STAGES && used < length; stage++)
+		if (timing->stageStart[stage] >= 0)
+			used += snprintf(buffer + used, length - used, "  %-18s %-8s %12.3f %12.3f \n", names[stage], threads[stage],
+			                 timing->stageStart[stage] / 1e6, timing->stageTime[stage] / 1e6);
+	if (used < length)
+		used += snprintf(buffer + used, length - used,
+		                 "Semaphore wait: thread 1 %.3f ms, thread 2 %.3f ms \n"
+		                 "Thread 1 sent %lld frames (%lld bytes) in %.3f ms, thread 2 received them in %.3f ms and wrote the file in %.3f ms \n"
+		                 "Total: %.3f ms \n",
+		                 timing->semaphoreWait[THREAD_1] / 1e6, timing->semaphoreWait[THREAD_2] / 1e6, timing->framesSent,
+		                 timing->bytesSent, timing->sendTime / 1e6, timing->receiveTime / 1e6, timing->fileTime / 1e6,
+		                 nanosecondsSince(&timing->start) / 1e6);
+	return used;
 }
+/* ************************ End of Methods and functions for timing a run **************************** */
 
-void printProcesses(struct_process_info *processes, int arraySize, int timeQuantum)
+
+
+
+
+/* ************************ Methods and functions for streaming frames through the FIFO **************************** */
+/*
+ * @brief - initialiseFrameWriter - starts an empty batch of trace events that is written to the ring, or to fd if ring is NULL
+ *
+ * Inputs: traceSchedule - 1 to write every event, 0 to only write completions for the results of each process
+ */
+void initialiseFrameWriter(struct_frame_writer *writer, int fd, struct_ring *ring, int traceSchedule)
 {
-	int i;
-	printf("Details of each process:\n");
-	for (i = 0; i < arraySize; i++)
-		printf("Process[%d]: Arrive Time: %d, Burst time: %d, Time quantum: %d\n", processes[i].processId, processes[i].arriveTime,
-		       processes[i].burstTime, timeQuantum);  //print contents of each process.
-	puts("");
+	writer->fd = fd;
+	writer->ring = ring;
+	writer->traceSchedule = traceSchedule;
+	writer->used = sizeof (struct_frame_header);
+	writer->events = 0;
+	writer->timing = NULL;
 }
 
-/* ************************ End methods for handling process data **************************** */
-
+/*
+ * @brief - traceToFrames - trace function that adds an event to the batch of a struct_frame_writer
+ *
+ * The batch is written as one FRAME_TRACE frame when it is full, so the FIFO is written once per
+ * (FRAME_BATCH_BYTES / sizeof (struct_trace_event)) events. When the FIFO is full the write waits for thread 2,
+ * which keeps the memory used the same however long the trace is.
+ */
+void traceToFrames(void *context, int event, int timeCounter, const struct_process_info *process)
+{
+	struct_frame_writer *writer = (struct_frame_writer*) context;
+	struct_trace_event *traceEvent;
 
+	if (!writer->traceSchedule && event != TRACE_COMPLETE)
+		return;
+	if (writer->used + sizeof (struct_trace_event) > FRAME_BATCH_BYTES)
+		flushFrame(writer);
+	traceEvent = (struct_trace_event*) (writer->buffer + writer->used);
+	traceEvent->event = event;
+	traceEvent->timeCounter = timeCounter;
+	traceEvent->processId = process->processId;
+	traceEvent->remainingTime = process->remainingTime;
+	traceEvent->arriveTime = process->arriveTime;
+	traceEvent->burstTime = process->burstTime;
+	traceEvent->waitTime = process->waitTime;
+	traceEvent->turnAroundTime = process->turnAroundTime;
+	writer->used += sizeof (struct_trace_event);
+	writer->events++;
+}
 
+/*
+ * @brief - flushFrame - writes the trace events collected so far as one frame
+ */
+int flushFrame(struct_frame_writer *writer)
+{
+	struct_frame_header *header = (struct_frame_header*) writer->buffer;
 
+	if (writer->used == sizeof (struct_frame_header)) //no events to write
+		return 0;
+	header->type = FRAME_TRACE;
+	header->length = writer->used - sizeof (struct_frame_header);
+	writer->used = sizeof (struct_frame_header);
+	return sendFrame(writer, header->length + sizeof (struct_frame_header));
+}
 
-/* ************************ Methods and functions for using Round robin **************************** */
 /*
- * @brief - sortByArrivalTimes - rearranges the order of the processes from lowest arrive time to highest arrive time
+ * @brief - writeFrame - writes the batched trace events, then a header and payload as one frame
  *
- * Inputs: *processes - pointer to an array of processes - in which the function accesses the arrive times of each process in the array
- 			arraySize - size of the array - as the array size cannot be passed down from a pointer
+ * The payload must fit in FRAME_BATCH_BYTES.
+ */
+int writeFrame(struct_frame_writer *writer, uint32_t type, const void *payload, uint32_t length)
+{
+	struct_frame_header *header = (struct_frame_header*) writer->buffer;
+
+	if (length > FRAME_BATCH_BYTES - sizeof (struct_frame_header))
+		return -1;
+	flushFrame(writer);
+	header->type = type;
+	header->length = length;
+	memcpy(writer->buffer + sizeof (struct_frame_header), payload, length);
+	return sendFrame(writer, sizeof (struct_frame_header) + length);
+}
+
+/*
+ * @brief - sendFrame - writes the first length bytes of the buffer, a whole frame, to the ring or the FIFO
  *
+ * When the run is timed, the time taken is added to the send time, which includes waiting for thread 2 to make room.
  */
-int sortByArrivalTimes(struct_process_info *processes, int arraySize) //function only receives pointer value, thats why
-//the array size must be passed seperately.
+int sendFrame(struct_frame_writer *writer, size_t length)
+{
+	struct timespec start;
+	int result;
+
+	if (writer->timing != NULL)
+		clock_gettime(CLOCK_MONOTONIC, &start);
+	if (writer->ring != NULL)
+		result = RingWrite(writer->ring, writer->buffer, length);
+	else
+		result = writeAll(writer->fd, writer->buffer, length);
+	if (writer->timing != NULL)
+	{
+		writer->timing->sendTime += nanosecondsSince(&start);
+		writer->timing->framesSent++;
+		writer->timing->bytesSent += length;
+	}
+	return result;
+}
+
+/*
+ * @brief - writeAll - writes the whole buffer, carrying on after a write that was interrupted or only partly done
+ */
+int writeAll(int fd, const void *buffer, size_t length)
 {
-	struct_process_info temp[arraySize], swap;
-	int index1, index2;
+	const char *position = (const char*) buffer;
+	ssize_t written;
 
-	for (index1 = 0; index1 < arraySize - 1; index1++)
+	while (length > 0)
 	{
-		for (index2 = 0; index2 < arraySize - index1 - 1; index2++)
+		written = write(fd, position, length);
+		if (written < 0)
 		{
-			if (processes[index2].arriveTime > processes[index2 + 1].arriveTime)
-			{
-				swap = processes[index2];
-				processes[index2] = processes[index2 + 1]; //bubble sorts the processes according to arrival times in ascending order
-				processes[index2 + 1] = swap;
-			}
+			if (errno == EINTR)
+				continue;
+			perror("write");
+			return -1;
 		}
+		position += written;
+		length -= written;
 	}
-	processes = temp;
+	return 0;
 }
 
-void roundRobin(struct_process_info *processes, int arraySize, int timeQuantum)
+/*
+ * @brief - readFrames - reads frames from the ring, or from fd if ring is NULL, until it is closed and writes them into the file
+ *
+ * The FIFO or ring is read FRAME_READ_BYTES at a time and every whole frame in the buffer is handled before reading again, so
+ * a frame that is split between two reads is moved to the start of the buffer and completed by the next read.
+ * Trace events are written to the file as lines, and the summary is written with writeToFile.
+ * Returns the number of frames read.
+ */
+int readFrames(int fd, struct_ring *ring, FILE *fp, const struct_options *options)
 {
-	int timeCounter = processes[0].arriveTime; //start the time when the first process arrives
-	int flag = 0;
-	int index;
-	int tq = 0;
-	int timeLeft = 0;
-
-	Queue *processQueue = ConstructQueue(arraySize);
-	NODE *pN;
-	NODE *processNode;
+	char *buffer, *position;
+	char summary[FRAME_BATCH_BYTES + 1];
+	struct_frame_header header;
+	struct_timing *timing = options->timing; //NULL unless the run is timed with -T
+	struct timespec start; //when the current read, or the handling of the frames it read, started
+	size_t used = 0;
+	ssize_t n;
+	int frames = 0;
 
-	while (flag < arraySize) //run loop until all the processes have been completed
+	buffer = (char*) malloc(FRAME_READ_BYTES);
+	if (buffer == NULL)
 	{
-		for (index = 0; index < arraySize; index++) //loop
+		perror("malloc");
+		return 0;
+	}
+	if (timing != NULL)
+		clock_gettime(CLOCK_MONOTONIC, &start);
+	while ((n = (ring != NULL ? RingRead(ring, buffer + used, FRAME_READ_BYTES - used) :
+	            read(fd, buffer + used, FRAME_READ_BYTES - used))) != 0)
+	{
+		if (timing != NULL)
 		{
-			if (processes[index].arriveTime == timeCounter && processes[index].remainingTime != 0) //if the process has arrived and the remaining time
-			{	//is not 0
-				pN = (NODE*) malloc(sizeof (NODE));
-				pN->data = &processes[index];
-				Enqueue(processQueue, pN); //store the process in the queue
-			}
+			timing->receiveTime += nanosecondsSince(&start);
+			clock_gettime(CLOCK_MONOTONIC, &start);
 		}
-
-		if (isEmpty(processQueue) == 0)	//if the queue is not empty
+		if (n < 0)
 		{
-			processNode = front(processQueue); //get the first process in the queue
-			if (processNode->data->remainingTime <= timeQuantum && timeLeft == 0) //if remaining time is less than or equal to
-				//time quantum and is currently not running
-				timeLeft = processNode->data->remainingTime;
-			else if (processNode->data->remainingTime > timeQuantum && timeLeft == 0) //if remaining time is greater than time quantum
-				timeLeft = timeQuantum;
-
-			timeLeft--;
-			timeCounter++;
-			processNode->data->remainingTime--;
-
-			if (processNode->data->remainingTime == 0) //if the remaining time is 0, process is completed.
+			if (errno == EINTR)
+				continue;
+			perror("read");
+			break;
+		}
+		used += n;
+		position = buffer;
+		while (used - (position - buffer) >= sizeof header) //handle every whole frame in the buffer
+		{
+			memcpy(&header, position, sizeof header);
+			if (header.length > FRAME_BATCH_BYTES - sizeof header) //not a frame that was written by thread 1
 			{
-				processNode->data->turnAroundTime = timeCounter - processNode->data->arriveTime; //since the process is done, calculate the turnaround time
-				//line below is for debugging purposes
-				//printf("Process[%d]: time - %d, remaining time - %d\n", processNode->data->processId, timeCounter, processNode->data->remainingTime);
-				processNode->data->waitTime = processNode->data->turnAroundTime  - processNode->data->burstTime; //since the process is done, calculate the wait time
-				flag++;
-				processNode = Dequeue(processQueue); //remove the process from the queue
-				free(processNode); //delete the process node
+				printf("Bad frame in the FIFO\n");
+				free(buffer);
+				return frames;
 			}
-			else if (timeLeft == 0) //if the process finished running but not fully completed
+			if (used - (position - buffer) < sizeof header + header.length) //the rest of the frame has not arrived yet
+				break;
+			position += sizeof header;
+			if (header.type == FRAME_TRACE)
+				writeTraceEvents(fp, (const struct_trace_event*) position, header.length / sizeof (struct_trace_event), options);
+			else if (header.type == FRAME_SUMMARY)
 			{
-				//line below is for debugging purposes
-				//printf("Process[%d]: time - %d, remaining time - %d\n", processNode->data->processId, timeCounter, processNode->data->remainingTime);
-				processNode = Dequeue(processQueue); //remove the process node from the queue
-				Enqueue(processQueue, processNode); //requeue the process node at the end of the queue
+				memcpy(summary, position, header.length);
+				summary[header.length] = 0; //the string is written to the FIFO without its terminator
+				writeToFile(fp, summary);
+			}
+			else if (header.type == FRAME_TEXT)
+			{
+				memcpy(summary, position, header.length);
+				summary[header.length] = 0;
+				fputs(summary, fp);
 			}
+			position += header.length;
+			frames++;
 		}
+		used -= position - buffer; //keep the part of a frame that has not fully arrived
+		memmove(buffer, position, used);
+		if (timing != NULL)
+		{
+			timing->fileTime += nanosecondsSince(&start);
+			clock_gettime(CLOCK_MONOTONIC, &start);
+		}
+	}
+	if (timing != NULL) //the last read, which found the end
+		timing->receiveTime += nanosecondsSince(&start);
+	free(buffer);
+	return frames;
+}
+
+/*
+ * @brief - writeTraceEvents - writes a batch of trace events to the file
+ *
+ * With -g every event is written as a line of the schedule, and with -r every completion is also written as a line
+ * with the results of the process.
+ */
+int writeTraceEvents(FILE *fp, const struct_trace_event *events, size_t count, const struct_options *options)
+{
+	static const char *names[] = {"dispatched", "preempted", "completed"};
+	size_t index;
+
+	for (index = 0; index < count; index++)
+	{
+		if (options->traceSchedule)
+			fprintf(fp, "Time %d: Process[%d] %s, remaining time %d\n", events[index].timeCounter, events[index].processId,
+			        events[index].event >= 0 && events[index].event <= TRACE_COMPLETE ? names[events[index].event] : "unknown",
+			        events[index].remainingTime);
+		if (options->processResults && events[index].event == TRACE_COMPLETE)
+			fprintf(fp, "Process[%d] Arrive Time: %d, Burst Time: %d, Wait Time: %d, Turnaround Time: %d\n",
+			        events[index].processId, events[index].arriveTime, events[index].burstTime, events[index].waitTime,
+			        events[index].turnAroundTime);
+	}
+	return 0;
+}
+/* ************************ End of Methods and functions for streaming frames through the FIFO **************************** */
+
+
+
+
+
+/* ************************ Methods and functions for the ring between the threads **************************** */
+/*
+ * @brief - ringBytes - size of the block of memory that holds a ring with capacity bytes of data
+ */
+size_t ringBytes(size_t capacity)
+{
+	return sizeof (struct_ring) + capacity;
+}
+
+/*
+ * @brief - initialiseRing - sets up an empty ring in a block of ringBytes(capacity) bytes
+ *
+ * Inputs: *ring - the block of memory
+ 			capacity - bytes of data, a power of two
+ 			shared - 1 if the ring is in memory shared between processes, 0 if it is only used by threads
+ *
+ * Returns 0 on success or -1 if the capacity is not a power of two or the semaphores cannot be created.
+ */
+int initialiseRing(struct_ring *ring, size_t capacity, int shared)
+{
+	if (capacity == 0 || (capacity & (capacity - 1)) != 0)
+		return -1;
+	atomic_init(&ring->head, 0);
+	atomic_init(&ring->tail, 0);
+	atomic_init(&ring->consumerWaiting, 0);
+	atomic_init(&ring->producerWaiting, 0);
+	atomic_init(&ring->closed, 0);
+	atomic_init(&ring->magic, 0);
+	ring->capacity = capacity;
+	if (sem_init(&ring->dataReady, shared, 0) == -1)
+		return -1;
+	if (sem_init(&ring->spaceReady, shared, 0) == -1)
+	{
+		sem_destroy(&ring->dataReady);
+		return -1;
+	}
+	atomic_store(&ring->magic, RING_MAGIC); //set last - everything above is visible to whoever sees the magic
+	return 0;
+}
+
+/*
+ * @brief - ConstructRing - allocates a ring used by two threads of this process, aligned to a cache line
+ */
+struct_ring *ConstructRing(size_t capacity)
+{
+	void *memory;
+
+	if (posix_memalign(&memory, CACHE_LINE, ringBytes(capacity)) != 0)
+		return NULL;
+	if (initialiseRing((struct_ring*) memory, capacity, 0) != 0)
+	{
+		free(memory);
+		return NULL;
+	}
+	return (struct_ring*) memory;
+}
+
+void DestructRing(struct_ring *ring)
+{
+	if (ring == NULL)
+		return;
+	sem_destroy(&ring->dataReady);
+	sem_destroy(&ring->spaceReady);
+	free(ring);
+}
+
+/*
+ * @brief - RingWrite - copies the whole buffer into the ring, waiting while the ring is full
+ *
+ * Only the producer calls this. The bytes are copied before head is moved past them, so the consumer never sees bytes
+ * that have not been written. The consumer's semaphore is only posted when it has said it is waiting, so a producer
+ * that stays ahead of the consumer makes no system calls.
+ */
+int RingWrite(struct_ring *ring, const void *buffer, size_t length)
+{
+	const char *position = (const char*) buffer;
+	size_t head = atomic_load_explicit(&ring->head, memory_order_relaxed);
+	size_t space, offset, part;
+
+	while (length > 0)
+	{
+		space = ring->capacity - (head - atomic_load_explicit(&ring->tail, memory_order_acquire));
+		if (space == 0) //wait for the consumer to read some of the ring
+		{
+			atomic_store(&ring->producerWaiting, 1);
+			if (ring->capacity - (head - atomic_load(&ring->tail)) == 0) //check again now the consumer can see we are waiting
+				while (sem_wait(&ring->spaceReady) == -1 && errno == EINTR)
+					;
+			atomic_store(&ring->producerWaiting, 0);
+			continue;
+		}
+		if (space > length)
+			space = length;
+		offset = head & (ring->capacity - 1);
+		part = ring->capacity - offset; //bytes before the end of data, the rest wraps round to the start
+		if (part > space)
+			part = space;
+		memcpy(ring->data + offset, position, part);
+		memcpy(ring->data, position + part, space - part);
+		head += space;
+		position += space;
+		length -= space;
+		atomic_store(&ring->head, head); //publish the bytes
+		if (atomic_load(&ring->consumerWaiting) && atomic_exchange(&ring->consumerWaiting, 0))
+			sem_post(&ring->dataReady);
+	}
+	return 0;
+}
+
+/*
+ * @brief - RingRead - copies up to length bytes out of the ring, waiting while it is empty
+ *
+ * Only the consumer calls this. Returns the number of bytes copied, or 0 once the ring is closed and empty, the same
+ * as read() on the FIFO.
+ */
+ssize_t RingRead(struct_ring *ring, void *buffer, size_t length)
+{
+	size_t tail = atomic_load_explicit(&ring->tail, memory_order_relaxed);
+	size_t available, offset, part;
+
+	while ((available = atomic_load_explicit(&ring->head, memory_order_acquire) - tail) == 0)
+	{
+		if (atomic_load(&ring->closed))
+		{
+			if (atomic_load(&ring->head) == tail) //nothing was written between the two loads
+				return 0;
+			continue;
+		}
+		atomic_store(&ring->consumerWaiting, 1);
+		if (atomic_load(&ring->head) == tail && !atomic_load(&ring->closed)) //check again now the producer can see we are waiting
+			while (sem_wait(&ring->dataReady) == -1 && errno == EINTR)
+				;
+		atomic_store(&ring->consumerWaiting, 0);
+	}
+	if (available > length)
+		available = length;
+	offset = tail & (ring->capacity - 1);
+	part = ring->capacity - offset;
+	if (part > available)
+		part = available;
+	memcpy(buffer, ring->data + offset, part);
+	memcpy((char*) buffer + part, ring->data, available - part);
+	atomic_store(&ring->tail, tail + available); //give the space back to the producer
+	if (atomic_load(&ring->producerWaiting) && atomic_exchange(&ring->producerWaiting, 0))
+		sem_post(&ring->spaceReady);
+	return available;
+}
+
+/*
+ * @brief - RingClose - tells the consumer that nothing more will be written
+ */
+void RingClose(struct_ring *ring)
+{
+	atomic_store(&ring->closed, 1);
+	if (atomic_exchange(&ring->consumerWaiting, 0))
+		sem_post(&ring->dataReady);
+}
+/* ************************ End of Methods and functions for the ring between the threads **************************** */
+
+
+
+
+
+/* ************************ Methods and functions for the ring in shared memory **************************** */
+/*
+ * @brief - CreateSharedRing - creates a ring in new POSIX shared memory called name and maps it
+ *
+ * Inputs: flags - RING_TRACE_SCHEDULE and RING_PROCESS_RESULTS for what will be written, read by the other process
+ *
+ * The semaphores are process shared, so the ring can be written by this process and read by another one that calls
+ * AttachSharedRing. After the mapping nothing but the ring's own doorbells needs a system call.
+ * Returns NULL if the shared memory already exists or cannot be created.
+ */
+struct_ring *CreateSharedRing(const char *name, size_t capacity, unsigned int flags)
+{
+	struct_ring *ring;
+	int fd;
+
+	if ((fd = shm_open(name, O_RDWR | O_CREAT | O_EXCL, S_IRUSR | S_IWUSR)) < 0)
+	{
+		perror("shm_open");
+		return NULL;
+	}
+	if (ftruncate(fd, ringBytes(capacity)) != 0)
+	{
+		perror("ftruncate");
+		close(fd);
+		shm_unlink(name);
+		return NULL;
+	}
+	ring = (struct_ring*) mmap(NULL, ringBytes(capacity), PROT_READ | PROT_WRITE, MAP_SHARED, fd, 0);
+	close(fd); //the mapping stays after the descriptor is closed
+	if (ring == MAP_FAILED)
+	{
+		perror("mmap");
+		shm_unlink(name);
+		return NULL;
+	}
+	ring->flags = flags; //set before initialiseRing publishes the magic
+	if (initialiseRing(ring, capacity, 1) != 0)
+	{
+		printf("Cannot set up the ring in %s\n", name);
+		munmap(ring, ringBytes(capacity));
+		shm_unlink(name);
+		return NULL;
+	}
+	return ring;
+}
+
+/*
+ * @brief - AttachSharedRing - maps a ring made by CreateSharedRing in another process
+ *
+ * The ring may not have been created yet, so this tries RING_ATTACH_TRIES times before giving up.
+ */
+struct_ring *AttachSharedRing(const char *name)
+{
+	struct_ring *ring;
+	struct stat info;
+	int fd, tries;
+
+	for (tries = 0; tries < RING_ATTACH_TRIES; tries++)
+	{
+		if (tries > 0)
+			usleep(100000);
+		if ((fd = shm_open(name, O_RDWR, 0)) < 0)
+			continue;
+		if (fstat(fd, &info) != 0 || info.st_size < (off_t) sizeof (struct_ring)) //not resized yet
+		{
+			close(fd);
+			continue;
+		}
+		ring = (struct_ring*) mmap(NULL, info.st_size, PROT_READ | PROT_WRITE, MAP_SHARED, fd, 0);
+		close(fd);
+		if (ring == MAP_FAILED)
+		{
+			perror("mmap");
+			return NULL;
+		}
+		if (atomic_load(&ring->magic) == RING_MAGIC && ringBytes(ring->capacity) == (size_t) info.st_size)
+			return ring;
+		munmap(ring, info.st_size); //not set up yet
+	}
+	printf("Cannot attach to the ring in %s\n", name);
+	return NULL;
+}
+
+/*
+ * @brief - ReleaseSharedRing - waits for another process to read everything written to a ring in named shared memory,
+ *			then removes the name
+ *
+ * The reporting process removes the name itself once it has attached. If the ring is still not read after
+ * RING_ATTACH_TRIES tries, 100 ms apart, in which the reader made no progress, the name is removed here so that
+ * nothing is left behind in /dev/shm, and whatever was not read is lost.
+ * Returns 0 once the ring has been read, or -1 if it was not read in time.
+ */
+int ReleaseSharedRing(struct_ring *ring, const char *name)
+{
+	size_t tail = atomic_load(&ring->tail);
+	int tries;
+
+	for (tries = 0; atomic_load(&ring->tail) != atomic_load(&ring->head) && tries < RING_ATTACH_TRIES; tries++)
+	{
+		usleep(100000);
+		if (atomic_load(&ring->tail) != tail) //the reader is still reading - give it as long again
+		{
+			tail = atomic_load(&ring->tail);
+			tries = 0;
+		}
+	}
+	shm_unlink(name); //fails harmlessly if the reporting process has already removed it
+	return atomic_load(&ring->tail) == atomic_load(&ring->head) ? 0 : -1;
+}
+
+/*
+ * @brief - DetachSharedRing - unmaps a shared ring - the semaphores are not destroyed as the other process may still use them
+ */
+void DetachSharedRing(struct_ring *ring)
+{
+	munmap(ring, ringBytes(ring->capacity));
+}
+/* ************************ End of Methods and functions for the ring in shared memory **************************** */
+
+
+
+
+
+/* ************************ Methods and functions for read/writing to files **************************** */
+int writeToFile(FILE *f, char *buffer)
+{
+	fputs(buffer, f); /*put contents of the buffer into the file  */
+	printf("Content written to file:-\n%s", buffer);
+	return 0;
+}
+
+/* ************************ End of Methods and functions for read/writing to files **************************** */
+
+
+
+
+
+/* ************************ Methods for handling process data **************************** */
+
+
+/*
+ * @brief - askForProcesses - asks the user how many processes there are and then for the details of each one
+ *
+ * Returns a new array of *numOfProcesses processes that the caller frees.
+ */
+struct_process_info *askForProcesses(int *numOfProcesses, int askPriority)
+{
+	struct_process_info *processes;
+	do {
+		printf("Enter number of processes ");
+	}
+	while (getNumber(numOfProcesses) != 0); //get number of processes - number must be a non-negative integer
+
+	processes = (struct_process_info*) malloc(sizeof (struct_process_info) * (*numOfProcesses > 0 ? *numOfProcesses : 1));
+	if (processes == NULL)
+	{
+		perror("malloc");
+		exit(1);
+	}
+	initialiseProcesses(processes, *numOfProcesses, askPriority); //get process data - how many processes, arrival times and burst time
+	return processes;
+}
+
+void initialiseProcesses(struct_process_info *processes, int arraySize, int askPriority)
+{
+	int index;
+	for (index = 0; index < arraySize; index++)
+	{
+		processes[index].processId = index + 1;
+		processes[index].waitTime = 0;
+		printf("Process[%d]: What is the arrive Time? ", processes[index].processId); //get arrive time of the process from the user
+		getNumber(&processes[index].arriveTime);
+
+		printf("Process[%d]: What is the burst Time? ", processes[index].processId); //get burst time from the user
+		getNumber(&processes[index].burstTime);
+
+		processes[index].priority = 0;
+		if (askPriority) //only asked for when the policy uses it
+		{
+			printf("Process[%d]: What is the priority? ", processes[index].processId);
+			getNumber(&processes[index].priority);
+		}
+
+		processes[index].remainingTime = processes[index].burstTime; //set remainingtime to the burst time
+		processes[index].turnAroundTime = 0; //set turnaround time and wait time as 0 so that they are initalised.
+		processes[index].waitTime = 0;
+		puts("");
+	}
+}
+
+/*
+ * @brief - loadWorkload - reads every process from a text or binary workload file
+ *
+ * Inputs: *path - the workload file
+ 			**processes - set to a new array holding the processes, which the caller frees
+ 			*arraySize - set to the number of processes
+ *
+ * The file is memory-mapped and parsed in place. A file starting with WORKLOAD_MAGIC is read as the binary format,
+ * anything else as text. The processes are numbered from 1 in the order they appear in the file.
+ * Returns 0 on success or -1 after printing why the file could not be read.
+ */
+int loadWorkload(const char *path, struct_process_info **processes, int *arraySize)
+{
+	struct stat fileInfo;
+	char *data = NULL;
+	int fd, result;
+
+	if ((fd = open(path, O_RDONLY)) < 0 || fstat(fd, &fileInfo) < 0)
+	{
+		perror(path);
+		if (fd >= 0)
+			close(fd);
+		return -1;
+	}
+	if (fileInfo.st_size > 0)
+	{
+		data = mmap(NULL, fileInfo.st_size, PROT_READ, MAP_PRIVATE, fd, 0);
+		if (data == MAP_FAILED)
+		{
+			perror("mmap");
+			close(fd);
+			return -1;
+		}
+		madvise(data, fileInfo.st_size, MADV_SEQUENTIAL); //the file is only read once from start to end
+	}
+	close(fd); //the mapping stays valid after the file is closed
+
+	if (fileInfo.st_size >= (off_t) sizeof (struct_workload_header) && memcmp(data, WORKLOAD_MAGIC, 4) == 0)
+		result = parseWorkloadBinary(data, fileInfo.st_size, processes, arraySize);
+	else
+		result = parseWorkloadText(data, fileInfo.st_size, processes, arraySize);
+
+	if (data != NULL)
+		munmap(data, fileInfo.st_size);
+	if (result != 0)
+		printf("Could not read the workload in %s\n", path);
+	return result;
+}
+
+/*
+ * @brief - parseWorkloadText - reads "arrive time, burst time[, priority]" lines, one process per line
+ *
+ * The numbers can be separated by a comma, spaces or tabs and the priority is 0 when it is left out. Blank lines, lines starting with # and a first line
+ * that does not start with a digit (a column header) are skipped.
+ */
+int parseWorkloadText(const char *text, size_t length, struct_process_info **processes, int *arraySize)
+{
+	const char *position = text, *end = text + length, *lineEnd;
+	long values[3];
+	size_t lines = 1, line = 0, index;
+	int count = 0, result;
+
+	for (index = 0; index < length; index++) //there is at most one process per line
+		if (text[index] == '\n')
+			lines++;
+	if (lines > INT_MAX)
+	{
+		printf("Too many lines in the workload\n");
+		return -1;
+	}
+	*processes = (struct_process_info*) malloc(sizeof (struct_process_info) * lines);
+	if (*processes == NULL)
+	{
+		perror("malloc");
+		return -1;
+	}
+
+	while (position < end)
+	{
+		if ((lineEnd = memchr(position, '\n', end - position)) == NULL)
+			lineEnd = end;
+		result = parseWorkloadLine(position, lineEnd, ++line, values);
+		position = lineEnd + 1;
+		if (result < 0)
+		{
+			free(*processes);
+			return -1;
+		}
+		if (result > 0)
+		{
+			count++;
+			initialiseProcess(&(*processes)[count - 1], count, values[0], values[1], values[2]);
+		}
+	}
+	*arraySize = count;
+	return 0;
+}
+
+/*
+ * @brief - parseWorkloadLine - reads the numbers of one line of a text workload
+ *
+ * Inputs: *position, *end - the line, without its '\n'
+ 			line - the number of the line, counting from 1 - the first line may be a column header
+ 			values - set to the arrive time, burst time and priority
+ *
+ * Returns 1 if the line holds a process, 0 if it is blank, a comment or a header, or -1 after printing why it is not valid.
+ */
+int parseWorkloadLine(const char *position, const char *end, size_t line, long values[3])
+{
+	int value;
+
+	while (position < end && (*position == ' ' || *position == '\t' || *position == '\r'))
+		position++;
+	if (position == end || *position == '#' || (line == 1 && !isdigit((unsigned char) *position)))
+		return 0;
+
+	values[2] = 0;
+	for (value = 0; value < 3; value++)
+	{
+		if (value > 0) //skip the separator between two numbers
+		{
+			while (position < end && (*position == ' ' || *position == '\t'))
+				position++;
+			if (position < end && *position == ',')
+				position++;
+			while (position < end && (*position == ' ' || *position == '\t'))
+				position++;
+		}
+		if (value == 2 && (position == end || *position == '\r' || *position == '#'))
+			break; //the priority is optional
+		if (position == end || !isdigit((unsigned char) *position))
+		{
+			printf("Line %zu: expected two or three non-negative integers\n", line);
+			return -1;
+		}
+		values[value] = 0;
+		while (position < end && isdigit((unsigned char) *position))
+		{
+			values[value] = values[value] * 10 + (*position++ - '0');
+			if (values[value] > INT_MAX)
+			{
+				printf("Line %zu: number is too large\n", line);
+				return -1;
+			}
+		}
+	}
+	while (position < end && (*position == ' ' || *position == '\t' || *position == '\r' || *position == ','))
+		position++;
+	if (position < end && *position != '#')
+	{
+		printf("Line %zu: expected two or three non-negative integers\n", line);
+		return -1;
+	}
+	return 1;
+}
+
+/*
+ * @brief - initialiseProcess - sets up a process read from a workload so that it is ready to be scheduled
+ */
+void initialiseProcess(struct_process_info *process, int processId, int arriveTime, int burstTime, int priority)
+{
+	process->processId = processId;
+	process->arriveTime = arriveTime;
+	process->burstTime = burstTime;
+	process->remainingTime = burstTime;
+	process->priority = priority;
+	process->waitTime = 0;
+	process->turnAroundTime = 0;
+}
+
+/*
+ * @brief - parseWorkloadBinary - reads the fixed-size records of a binary workload file
+ */
+int parseWorkloadBinary(const char *data, size_t length, struct_process_info **processes, int *arraySize)
+{
+	const struct_workload_header *header = (const struct_workload_header*) data;
+	const char *records = data + sizeof (struct_workload_header);
+	const struct_workload_record *record;
+	size_t index, recordSize;
+
+	if (header->version == 1) //version 1 records stop before the priority
+		recordSize = 2 * sizeof (int32_t);
+	else if (header->version == WORKLOAD_VERSION)
+		recordSize = sizeof (struct_workload_record);
+	else
+	{
+		printf("Unsupported workload version %u\n", header->version);
+		return -1;
+	}
+	if (header->count > INT_MAX || header->count > (length - sizeof (struct_workload_header)) / recordSize)
+	{
+		printf("The workload header says it has %llu processes but the file is too short\n", (unsigned long long) header->count);
+		return -1;
+	}
+	*processes = (struct_process_info*) malloc(sizeof (struct_process_info) * (header->count > 0 ? header->count : 1));
+	if (*processes == NULL)
+	{
+		perror("malloc");
+		return -1;
+	}
+
+	for (index = 0; index < header->count; index++)
+	{
+		record = (const struct_workload_record*) (records + index * recordSize);
+		if (record->arriveTime < 0 || record->burstTime < 0)
+		{
+			printf("Process[%zu]: arrive time and burst time must not be negative\n", index + 1);
+			free(*processes);
+			return -1;
+		}
+		initialiseProcess(&(*processes)[index], index + 1, record->arriveTime, record->burstTime,
+		                  recordSize == sizeof (struct_workload_record) ? record->priority : 0);
+	}
+	*arraySize = header->count;
+	return 0;
+}
+
+/*
+ * @brief - saveWorkloadBinary - writes the processes to a binary workload file that loadWorkload can read back
+ *
+ * Returns 0 on success or -1 after printing why the file could not be written.
+ */
+int saveWorkloadBinary(const char *path, struct_process_info *processes, int arraySize)
+{
+	struct_workload_header header;
+	struct_workload_record records[4096]; //written a block of records at a time
+	FILE *f;
+	int index, count = 0, result = 0;
+
+	if ((f = fopen(path, "wb")) == NULL)
+	{
+		perror(path);
+		return -1;
+	}
+	memcpy(header.magic, WORKLOAD_MAGIC, 4);
+	header.version = WORKLOAD_VERSION;
+	header.count = arraySize;
+	if (fwrite(&header, sizeof header, 1, f) != 1)
+		result = -1;
+	for (index = 0; index < arraySize && result == 0; index++)
+	{
+		records[count].arriveTime = processes[index].arriveTime;
+		records[count].burstTime = processes[index].burstTime;
+		records[count].priority = processes[index].priority;
+		if (++count == 4096 || index == arraySize - 1)
+		{
+			if (fwrite(records, sizeof (struct_workload_record), count, f) != (size_t) count)
+				result = -1;
+			count = 0;
+		}
+	}
+	if (result != 0)
+		perror(path);
+	if (fclose(f) != 0 && result == 0)
+	{
+		perror(path);
+		result = -1;
+	}
+	return result;
+}
+
+/*
+ * @brief - saveResultsBinary - writes the results of every process to a binary results file that mapResults can read
+ *
+ * Inputs: *path - the results file
+ 			*processes - the processes of a schedule that has run, in the order they are written
+ 			arraySize - number of processes
+ *
+ * Each column is gathered from the processes into a page-aligned block of RESULTS_BLOCK_BYTES and written with one
+ * write per block, so the file is written in a few hundred large writes however many processes there are, instead
+ * of one formatted line per process. Returns 0 on success or -1 after printing why the file could not be written.
+ */
+int saveResultsBinary(const char *path, const struct_process_info *processes, int arraySize)
+{
+	struct_results_header header;
+	size_t columnBytes, bytes, padded;
+	void *block;
+	int fd, column, first, count, perBlock = RESULTS_BLOCK_BYTES / sizeof (int32_t), result = 0;
+
+	columnBytes = ((size_t) arraySize * sizeof (int32_t) + RESULTS_ALIGN - 1) / RESULTS_ALIGN * RESULTS_ALIGN;
+	memset(&header, 0, sizeof header);
+	memcpy(header.magic, RESULTS_MAGIC, 4);
+	header.version = RESULTS_VERSION;
+	header.count = arraySize;
+	header.columns = RESULT_COLUMNS;
+	header.valueBytes = sizeof (int32_t);
+	for (column = 0; column < RESULT_COLUMNS; column++)
+		header.offset[column] = RESULTS_ALIGN + column * columnBytes;
+
+	if (posix_memalign(&block, RESULTS_ALIGN, RESULTS_BLOCK_BYTES) != 0)
+	{
+		perror("posix_memalign");
+		return -1;
+	}
+	if ((fd = open(path, O_WRONLY | O_CREAT | O_TRUNC, 0644)) < 0)
+	{
+		perror(path);
+		free(block);
+		return -1;
+	}
+	memset(block, 0, RESULTS_ALIGN); //the header page
+	memcpy(block, &header, sizeof header);
+	result = writeAll(fd, block, RESULTS_ALIGN);
+	for (column = 0; column < RESULT_COLUMNS && result == 0; column++)
+	{
+		for (first = 0; first < arraySize && result == 0; first += count)
+		{
+			count = arraySize - first < perBlock ? arraySize - first : perBlock;
+			bytes = fillResultColumn((int32_t*) block, processes, first, count, column);
+			if (first + count == arraySize) //pad the end of the column so the next one starts on RESULTS_ALIGN
+			{
+				padded = (bytes + RESULTS_ALIGN - 1) / RESULTS_ALIGN * RESULTS_ALIGN;
+				memset((char*) block + bytes, 0, padded - bytes);
+				bytes = padded;
+			}
+			result = writeAll(fd, block, bytes);
+		}
+	}
+	if (close(fd) != 0 && result == 0)
+	{
+		perror(path);
+		result = -1;
+	}
+	free(block);
+	return result;
+}
+
+/*
+ * @brief - fillResultColumn - copies one field of count processes from index first into an array of values
+ *
+ * Returns the number of bytes filled in.
+ */
+size_t fillResultColumn(int32_t *values, const struct_process_info *processes, int first, int count, int column)
+{
+	int index;
+
+	processes += first;
+	switch (column)
+	{
+	case RESULT_PROCESS_ID:
+		for (index = 0; index < count; index++)
+			values[index] = processes[index].processId;
+		break;
+	case RESULT_ARRIVE_TIME:
+		for (index = 0; index < count; index++)
+			values[index] = processes[index].arriveTime;
+		break;
+	case RESULT_BURST_TIME:
+		for (index = 0; index < count; index++)
+			values[index] = processes[index].burstTime;
+		break;
+	case RESULT_WAIT_TIME:
+		for (index = 0; index < count; index++)
+			values[index] = processes[index].waitTime;
+		break;
+	case RESULT_TURNAROUND_TIME:
+		for (index = 0; index < count; index++)
+			values[index] = processes[index].turnAroundTime;
+		break;
+	default: //RESULT_COMPLETION_TIME
+		for (index = 0; index < count; index++)
+			values[index] = processes[index].arriveTime + processes[index].turnAroundTime;
+		break;
+	}
+	return sizeof (int32_t) * count;
+}
+
+/*
+ * @brief - mapResults - memory-maps a binary results file written by saveResultsBinary
+ *
+ * Inputs: *path - the results file
+ 			*results - set to the mapping, with a pointer to each column inside it - release it with unmapResults
+ *
+ * Nothing is copied - the pages of a column are only read from the file when the column is used.
+ * Returns 0 on success or -1 after printing why the file could not be read.
+ */
+int mapResults(const char *path, struct_results_file *results)
+{
+	struct stat fileInfo;
+	const struct_results_header *header;
+	int fd, column;
+
+	if ((fd = open(path, O_RDONLY)) < 0 || fstat(fd, &fileInfo) < 0)
+	{
+		perror(path);
+		if (fd >= 0)
+			close(fd);
+		return -1;
+	}
+	if (fileInfo.st_size < (off_t) sizeof (struct_results_header))
+	{
+		printf("%s is too short to be a results file\n", path);
+		close(fd);
+		return -1;
+	}
+	results->length = fileInfo.st_size;
+	results->data = mmap(NULL, results->length, PROT_READ, MAP_SHARED, fd, 0);
+	close(fd); //the mapping stays valid after the file is closed
+	if (results->data == MAP_FAILED)
+	{
+		perror("mmap");
+		return -1;
+	}
+
+	header = (const struct_results_header*) results->data;
+	if (memcmp(header->magic, RESULTS_MAGIC, 4) != 0 || header->version != RESULTS_VERSION ||
+	        header->columns != RESULT_COLUMNS || header->valueBytes != sizeof (int32_t))
+	{
+		printf("%s is not a version %d results file\n", path, RESULTS_VERSION);
+		munmap(results->data, results->length);
+		return -1;
+	}
+	results->count = header->count;
+	for (column = 0; column < RESULT_COLUMNS; column++)
+	{
+		if (header->offset[column] % sizeof (int32_t) != 0 || header->offset[column] > results->length ||
+		        header->count > (results->length - header->offset[column]) / sizeof (int32_t))
+		{
+			printf("The results header says it has %llu processes but %s is too short\n",
+			       (unsigned long long) header->count, path);
+			munmap(results->data, results->length);
+			return -1;
+		}
+		results->column[column] = (const int32_t*) ((const char*) results->data + header->offset[column]);
+	}
+	return 0;
+}
+
+void unmapResults(struct_results_file *results)
+{
+	munmap(results->data, results->length);
+}
+
+/*
+ * @brief - openWorkloadStream - opens a text or binary workload file to be read one process at a time
+ *
+ * Only STREAM_CHUNK_BYTES of the file are held in memory at once, whatever its length. The binary header is checked
+ * straight away. Returns NULL after printing why the file could not be opened.
+ */
+struct_workload_stream *openWorkloadStream(const char *path)
+{
+	struct_workload_stream *stream = (struct_workload_stream*) calloc(1, sizeof (struct_workload_stream));
+	struct_workload_header header;
+
+	if (stream == NULL || (stream->buffer = (char*) malloc(STREAM_CHUNK_BYTES)) == NULL)
+	{
+		perror("malloc");
+		free(stream);
+		return NULL;
+	}
+	stream->path = path;
+	stream->nextId = 1;
+	stream->lastArrival = INT_MIN;
+	if ((stream->fd = open(path, O_RDONLY)) < 0)
+	{
+		perror(path);
+		free(stream->buffer);
+		free(stream);
+		return NULL;
+	}
+	posix_fadvise(stream->fd, 0, 0, POSIX_FADV_SEQUENTIAL); //the file is only read once from start to end
+	if (fillWorkloadStream(stream) != 0)
+	{
+		closeWorkloadStream(stream);
+		return NULL;
+	}
+
+	if (stream->end >= sizeof (struct_workload_header) && memcmp(stream->buffer, WORKLOAD_MAGIC, 4) == 0)
+	{
+		memcpy(&header, stream->buffer, sizeof header);
+		if (header.version == 1) //version 1 records stop before the priority
+			stream->recordSize = 2 * sizeof (int32_t);
+		else if (header.version == WORKLOAD_VERSION)
+			stream->recordSize = sizeof (struct_workload_record);
+		else
+		{
+			printf("Unsupported workload version %u\n", header.version);
+			closeWorkloadStream(stream);
+			return NULL;
+		}
+		stream->binary = 1;
+		stream->remaining = header.count;
+		stream->start = sizeof header;
+	}
+	return stream;
+}
+
+/*
+ * @brief - fillWorkloadStream - moves the bytes not parsed yet to the start of the buffer and reads more after them
+ *
+ * Returns 0 on success, including at the end of the file, or -1 if the file could not be read.
+ */
+int fillWorkloadStream(struct_workload_stream *stream)
+{
+	ssize_t n;
+
+	memmove(stream->buffer, stream->buffer + stream->start, stream->end - stream->start);
+	stream->end -= stream->start;
+	stream->start = 0;
+	while (!stream->endOfFile && stream->end < STREAM_CHUNK_BYTES)
+	{
+		n = read(stream->fd, stream->buffer + stream->end, STREAM_CHUNK_BYTES - stream->end);
+		if (n < 0 && errno == EINTR)
+			continue;
+		if (n < 0)
+		{
+			perror(stream->path);
+			return -1;
+		}
+		if (n == 0)
+			stream->endOfFile = 1;
+		stream->end += n;
+	}
+	return 0;
+}
+
+/*
+ * @brief - readWorkloadStream - reads the next process of a streamed workload
+ *
+ * The processes are numbered from 1 in the order they appear in the file, the same as loadWorkload, and must be in
+ * order of arrive time because the schedule starts before the rest of the file has been read.
+ * Returns 1 if a process was read, 0 at the end of the file or -1 after printing why the file is not valid.
+ */
+int readWorkloadStream(struct_workload_stream *stream, struct_process_info *process)
+{
+	struct_workload_record record;
+	long values[3];
+	char *lineEnd;
+	int result = 0;
+
+	while (result == 0)
+	{
+		if (stream->binary)
+		{
+			if (stream->remaining == 0)
+				return 0;
+			if (stream->end - stream->start < stream->recordSize && fillWorkloadStream(stream) != 0)
+				return -1;
+			if (stream->end - stream->start < stream->recordSize)
+			{
+				printf("%s ends before the %llu processes its header says it has\n", stream->path,
+				       (unsigned long long) stream->nextId - 1 + stream->remaining);
+				return -1;
+			}
+			record.priority = 0;
+			memcpy(&record, stream->buffer + stream->start, stream->recordSize);
+			stream->start += stream->recordSize;
+			stream->remaining--;
+			if (record.arriveTime < 0 || record.burstTime < 0)
+			{
+				printf("Process[%d]: arrive time and burst time must not be negative\n", stream->nextId);
+				return -1;
+			}
+			values[0] = record.arriveTime;
+			values[1] = record.burstTime;
+			values[2] = record.priority;
+			result = 1;
+		}
+		else
+		{
+			lineEnd = memchr(stream->buffer + stream->start, '\n', stream->end - stream->start);
+			if (lineEnd == NULL && !stream->endOfFile) //the line goes past the end of the buffer
+			{
+				if (fillWorkloadStream(stream) != 0)
+					return -1;
+				lineEnd = memchr(stream->buffer + stream->start, '\n', stream->end - stream->start);
+				if (lineEnd == NULL && !stream->endOfFile)
+				{
+					printf("Line %zu: longer than %d bytes\n", stream->line + 1, STREAM_CHUNK_BYTES);
+					return -1;
+				}
+			}
+			if (lineEnd == NULL) //the last line has no '\n'
+			{
+				if (stream->start == stream->end)
+					return 0;
+				lineEnd = stream->buffer + stream->end;
+			}
+			result = parseWorkloadLine(stream->buffer + stream->start, lineEnd, ++stream->line, values);
+			stream->start = lineEnd - stream->buffer + (lineEnd < stream->buffer + stream->end); //skip the '\n'
+			if (result < 0)
+				return -1;
+		}
+	}
+
+	if (values[0] < stream->lastArrival)
+	{
+		printf("Process[%d] arrives before the process before it - a streamed workload must be sorted by arrive time\n",
+		       stream->nextId);
+		return -1;
+	}
+	stream->lastArrival = values[0];
+	initialiseProcess(process, stream->nextId++, values[0], values[1], values[2]);
+	return 1;
+}
+
+void closeWorkloadStream(struct_workload_stream *stream)
+{
+	close(stream->fd);
+	free(stream->buffer);
+	free(stream);
+}
+
+void printProcesses(struct_process_info *processes, int arraySize, int timeQuantum)
+{
+	int i;
+	printf("Details of each process:\n");
+	for (i = 0; i < arraySize; i++)
+		printf("Process[%d]: Arrive Time: %d, Burst time: %d, Time quantum: %d\n", processes[i].processId, processes[i].arriveTime,
+		       processes[i].burstTime, timeQuantum);  //print contents of each process.
+	puts("");
+}
+
+/* ************************ End methods for handling process data **************************** */
+
+
+
+
+
+/* ************************ Methods and functions for using Round robin **************************** */
+/*
+ * @brief - sortByArrivalTimes - rearranges the order of the processes from lowest arrive time to highest arrive time
+ *
+ * Inputs: *processes - pointer to an array of processes - in which the function accesses the arrive times of each process in the array
+ 			arraySize - size of the array - as the array size cannot be passed down from a pointer
+ *
+ * Both sorts are stable, so processes that arrive at the same time keep their order by process id. Small inputs use
+ * the merge sort, larger ones the radix sort which only looks at each arrive time four times.
+ * Returns 0 on success or -1 if the memory for the sort could not be allocated.
+ */
+int sortByArrivalTimes(struct_process_info *processes, int arraySize) //function only receives pointer value, thats why
+//the array size must be passed seperately.
+{
+	if (arraySize >= RADIX_SORT_THRESHOLD)
+		return radixSortByArrivalTimes(processes, arraySize);
+	return mergeSortByArrivalTimes(processes, arraySize);
+}
+
+/*
+ * @brief - mergeSortByArrivalTimes - stable bottom-up merge sort of the processes by arrive time
+ *
+ * Inputs: *processes - pointer to an array of processes that is sorted in place
+ 			arraySize - size of the array - as the array size cannot be passed down from a pointer
+ *
+ * Runs of MERGE_SORT_RUN processes are first sorted with an insertion sort, then merged in pairs through a temporary
+ * buffer on the heap until the whole array is one run.
+ */
+int mergeSortByArrivalTimes(struct_process_info *processes, int arraySize)
+{
+	struct_process_info *temp, *from, *to, *swap, key;
+	int index1, index2, width, left, middle, right, out;
+
+	for (left = 0; left < arraySize; left += MERGE_SORT_RUN) //insertion sort each short run
+	{
+		right = left + MERGE_SORT_RUN < arraySize ? left + MERGE_SORT_RUN : arraySize;
+		for (index1 = left + 1; index1 < right; index1++)
+		{
+			key = processes[index1];
+			for (index2 = index1; index2 > left && processes[index2 - 1].arriveTime > key.arriveTime; index2--)
+				processes[index2] = processes[index2 - 1]; //only move processes that arrive later so ties stay in order
+			processes[index2] = key;
+		}
+	}
+	if (arraySize <= MERGE_SORT_RUN)
+		return 0;
+
+	temp = (struct_process_info*) malloc(sizeof (struct_process_info) * arraySize);
+	if (temp == NULL)
+		return -1;
+
+	from = processes;
+	to = temp;
+	for (width = MERGE_SORT_RUN; width < arraySize; width *= 2) //merge neighbouring runs into runs twice as long
+	{
+		for (left = 0; left < arraySize; left += 2 * width)
+		{
+			middle = left + width < arraySize ? left + width : arraySize;
+			right = left + 2 * width < arraySize ? left + 2 * width : arraySize;
+			index1 = left;
+			index2 = middle;
+			out = left;
+			while (index1 < middle && index2 < right) //take from the left run on ties to keep the sort stable
+				to[out++] = from[index2].arriveTime < from[index1].arriveTime ? from[index2++] : from[index1++];
+			while (index1 < middle)
+				to[out++] = from[index1++];
+			while (index2 < right)
+				to[out++] = from[index2++];
+		}
+		swap = from;
+		from = to;
+		to = swap;
+	}
+	if (from != processes) //the sorted processes ended up in the temporary buffer
+		memcpy(processes, from, sizeof (struct_process_info) * arraySize);
+	free(temp);
+	return 0;
+}
+
+/*
+ * @brief - radixSortByArrivalTimes - stable least significant digit radix sort of the processes by arrive time
+ *
+ * Inputs: *processes - pointer to an array of processes that is sorted in place
+ 			arraySize - size of the array - as the array size cannot be passed down from a pointer
+ *
+ * The arrive time is sorted one byte at a time. The counts for all four bytes are taken in a single pass and a byte
+ * that is the same for every process is skipped, so small arrive times only need one or two passes.
+ */
+int radixSortByArrivalTimes(struct_process_info *processes, int arraySize)
+{
+	struct_process_info *temp, *from, *to, *swap;
+	unsigned int key;
+	int counts[4][256] = {{0}};
+	int index, digit, shift, total, count;
+
+	for (index = 0; index < arraySize; index++) //count every byte of every arrive time in one pass
+	{
+		key = (unsigned int) processes[index].arriveTime ^ 0x80000000u; //flip the sign so negative times sort first
+		counts[0][key & 0xff]++;
+		counts[1][(key >> 8) & 0xff]++;
+		counts[2][(key >> 16) & 0xff]++;
+		counts[3][key >> 24]++;
+	}
+
+	temp = (struct_process_info*) malloc(sizeof (struct_process_info) * arraySize);
+	if (temp == NULL)
+		return -1;
+
+	from = processes;
+	to = temp;
+	for (digit = 0; digit < 4; digit++)
+	{
+		shift = digit * 8;
+		key = ((unsigned int) processes[0].arriveTime ^ 0x80000000u) >> shift & 0xff;
+		if (counts[digit][key] == arraySize) //every process has the same byte - nothing to move
+			continue;
+
+		total = 0;
+		for (index = 0; index < 256; index++) //turn the counts into the position each byte value starts at
+		{
+			count = counts[digit][index];
+			counts[digit][index] = total;
+			total += count;
+		}
+		for (index = 0; index < arraySize; index++) //scatter in order so that ties stay in order
+		{
+			key = ((unsigned int) from[index].arriveTime ^ 0x80000000u) >> shift & 0xff;
+			to[counts[digit][key]++] = from[index];
+		}
+		swap = from;
+		from = to;
+		to = swap;
+	}
+	if (from != processes) //the sorted processes ended up in the temporary buffer
+		memcpy(processes, from, sizeof (struct_process_info) * arraySize);
+	free(temp);
+	return 0;
+}
+
+/*
+ * @brief - roundRobin - the original round robin loop, which counts one time unit at a time
+ *
+ * Inputs: *config - the time quantum, the statistics and the trace function - the switch cost and dispatch latency
+ 			          are not modelled
+ *
+ * Each time slice is counted as a dispatch, and a switch if a different process ran last, and passed to the trace
+ * function with the preemption or completion that ends it, so -g and -r see the same events as the other policies.
+ * A slice starts at the first tick after the one before it ended, and a quantum of 0 never expires, the same as
+ * scheduleRoundRobin.
+ */
+void roundRobin(struct_process_info *processes, int arraySize, const struct_sim_config *config)
+{
+	int timeQuantum = config->timeQuantum;
+	int timeCounter = processes[0].arriveTime; //start the time when the first process arrives
+	int flag = 0;
+	int index;
+	int tq = 0;
+	int timeLeft = 0;
+	int running = 0; //1 while the process at the front of the queue is in a time slice
+	int lastRan = -1; //id of the process that ran last
+
+	Queue *processQueue = ConstructQueue(arraySize);
+	NODE *pN;
+	NODE *processNode;
+
+	while (flag < arraySize) //run loop until all the processes have been completed
+	{
+		for (index = 0; index < arraySize; index++) //loop
+		{
+			if (processes[index].arriveTime == timeCounter && processes[index].remainingTime != 0) //if the process has arrived and the remaining time
+			{	//is not 0
+				pN = AllocateNode(processQueue); //take a node from the queue's pool
+				pN->data = &processes[index];
+				Enqueue(processQueue, pN); //store the process in the queue
+			}
+			else if (processes[index].arriveTime == timeCounter) //a process with no burst time is completed as soon
+			{	//as it arrives, the same as admitArrivals
+				completeProcess(&processes[index], timeCounter, config->stats);
+				flag++;
+			}
+		}
+
+		if (isEmpty(processQueue) == 0)	//if the queue is not empty
+		{
+			processNode = front(processQueue); //get the first process in the queue
+			if (!running) //the process starts a new time slice
+			{
+				if (config->stats != NULL)
+				{
+					config->stats->dispatches++;
+					config->stats->contextSwitches += processNode->data->processId != lastRan;
+				}
+				lastRan = processNode->data->processId;
+				traceEvent(config, TRACE_DISPATCH, timeCounter, processNode->data);
+				running = 1;
+				if (processNode->data->remainingTime <= timeQuantum || timeQuantum <= 0) //if remaining time is less than or
+					//equal to time quantum, or the quantum is 0 and never expires
+					timeLeft = processNode->data->remainingTime;
+				else //if remaining time is greater than time quantum
+					timeLeft = timeQuantum;
+			}
+
+			timeLeft--;
+			timeCounter++;
+			processNode->data->remainingTime--;
+
+			if (processNode->data->remainingTime == 0) //if the remaining time is 0, process is completed.
+			{
+				//line below is for debugging purposes
+				//printf("Process[%d]: time - %d, remaining time - %d\n", processNode->data->processId, timeCounter, processNode->data->remainingTime);
+				completeProcess(processNode->data, timeCounter, config->stats); //since the process is done, calculate the turnaround time and wait time
+				traceEvent(config, TRACE_COMPLETE, timeCounter, processNode->data);
+				flag++;
+				running = 0;
+				processNode = Dequeue(processQueue); //remove the process from the queue
+				ReleaseNode(processQueue, processNode); //give the process node back to the pool
+			}
+			else if (timeLeft == 0) //if the process finished running but not fully completed
+			{
+				//line below is for debugging purposes
+				//printf("Process[%d]: time - %d, remaining time - %d\n", processNode->data->processId, timeCounter, processNode->data->remainingTime);
+				preemptProcess(config, timeCounter, processNode->data);
+				running = 0;
+				processNode = Dequeue(processQueue); //remove the process node from the queue
+				Enqueue(processQueue, processNode); //requeue the process node at the end of the queue
+			}
+		}
+		else
+			timeCounter++; //increment time
+	}
+	DestructQueue(processQueue); //free the memory used by the Queue struct and its nodes
+}
+
+/*
+ * @brief - admitArrivals - places every process that arrives before a given time into the queue
+ *
+ * Inputs: *processQueue - the ready queue the arriving processes are placed into
+ 			*processes - pointer to an array of processes sorted by arrive time
+ 			arraySize - size of the array - as the array size cannot be passed down from a pointer
+ 			*nextArrival - cursor to the first process that has not arrived yet - moved past every admitted process
+ 			beforeTime - processes with an arrive time lower than this are admitted
+ 			*stats - statistics the processes completed on arrival are added to, NULL for none
+ *
+ * Returns the number of processes that were completed on arrival because they have no burst time.
+ */
+int admitArrivals(Queue *processQueue, struct_process_info *processes, int arraySize, int *nextArrival, int beforeTime,
+                  struct_sim_stats *stats)
+{
+	int completed = 0;
+	NODE *pN;
+
+	while (*nextArrival < arraySize && processes[*nextArrival].arriveTime < beforeTime)
+	{
+		if (processes[*nextArrival].remainingTime != 0)
+		{
+			pN = AllocateNode(processQueue); //take a node from the queue's pool
+			pN->data = &processes[*nextArrival];
+			Enqueue(processQueue, pN); //store the process in the queue
+		}
+		else //a process with no burst time is completed as soon as it arrives
+		{
+			completeProcess(&processes[*nextArrival], processes[*nextArrival].arriveTime, stats);
+			completed++;
+		}
+		(*nextArrival)++;
+	}
+	return completed;
+}
+
+/*
+ * @brief - scheduleRoundRobin - runs the same round robin schedule as roundRobin() but jumps straight from one event
+ *			(arrival, quantum expiry or completion) to the next instead of counting one time unit at a time.
+ *
+ * Inputs: *processes - pointer to an array of processes sorted by arrive time - the results are written into each process
+ 			arraySize - size of the array - as the array size cannot be passed down from a pointer
+ 			*config - the time quantum, the longest time a process can run before it is placed at the back of the queue,
+ 			          and the statistics that each completed process is added to
+ *
+ * The processes are copied into a process table and scheduled by scheduleRoundRobinTable, which is the one round robin
+ * loop over a whole workload, then the results are copied back.
+ */
+void scheduleRoundRobin(struct_process_info *processes, int arraySize, const struct_sim_config *config)
+{
+	struct_process_table *table;
+
+	if (arraySize <= 0) //nothing to schedule
+		return;
+	if ((table = ConstructProcessTable(arraySize)) == NULL)
+	{
+		perror("malloc");
+		exit(1);
+	}
+	processTableFromArray(table, processes);
+	scheduleRoundRobinTable(table, config);
+	processTableToArray(table, processes);
+	DestructProcessTable(table);
+}
+
+/*
+ * @brief - roundRobinEventDriven - scheduleRoundRobin with only a time quantum and no statistics
+ */
+void roundRobinEventDriven(struct_process_info *processes, int arraySize, int timeQuantum)
+{
+	struct_sim_config config = {.timeQuantum = timeQuantum};
+	scheduleRoundRobin(processes, arraySize, &config);
+}
+
+/*
+ * @brief - scheduleRoundRobinStream - runs scheduleRoundRobin on a workload that is read from a file as the schedule runs
+ *
+ * Inputs: *stream - the workload, sorted by arrive time
+ 			*config - the same as scheduleRoundRobin - a completed process is only passed to the statistics and the
+ 			          trace function (-r writes each one to the output file as it completes)
+ *
+ * A process is read from the file when the simulated time reaches its arrival and is dropped as soon as it completes,
+ * so the memory used grows with the number of processes in the ready queue at once rather than the length of the
+ * file. The running process is taken off the front of the queue and put back at the end after the processes that
+ * arrived while it ran, the same order as scheduleRoundRobin, so the results are the same.
+ * Returns 0 on success or -1 if the file is not valid, with the processes completed so far in the statistics.
+ */
+int scheduleRoundRobinStream(struct_workload_stream *stream, const struct_sim_config *config)
+{
+	struct_live_queue queue = {NULL, 0, 0, 0};
+	struct_process_info next; //the next process to arrive, read ahead from the file
+	struct_process_info running;
+	int haveNext; //1 if next holds a process, 0 at the end of the file, -1 if the file is not valid
+	int timeCounter, runTime;
+	int lastRan = -1; //id of the process that ran last
+
+	if ((haveNext = readWorkloadStream(stream, &next)) <= 0) //an empty file has nothing to schedule
+		return haveNext;
+	timeCounter = next.arriveTime; //start the time when the first process arrives
+
+	while (1)
+	{
+		haveNext = admitStreamArrivals(stream, &queue, &next, haveNext, timeCounter + 1, config); //admit every process that has arrived
+		if (haveNext < 0)
+			break;
+		if (queue.size == 0) //the CPU is idle - jump straight to the next arrival
+		{
+			if (haveNext == 0)
+				break;
+			timeCounter = next.arriveTime;
+			continue;
+		}
+
+		LiveQueuePop(&queue, &running);
+		runTime = running.remainingTime;
+		if (config->timeQuantum > 0 && runTime > config->timeQuantum)
+			runTime = config->timeQuantum;
+		timeCounter += dispatchOverhead(config, &running, &lastRan);
+		traceEvent(config, TRACE_DISPATCH, timeCounter, &running);
+		timeCounter += runTime; //run the process until it completes or the time quantum expires
+		running.remainingTime -= runTime;
+
+		haveNext = admitStreamArrivals(stream, &queue, &next, haveNext, timeCounter, config); //processes that arrived while it was running
+
+		if (running.remainingTime == 0)
+		{
+			completeProcess(&running, timeCounter, config->stats);
+			traceEvent(config, TRACE_COMPLETE, timeCounter, &running);
+		}
+		else //the time quantum expired, requeue the process behind the arrivals
+		{
+			preemptProcess(config, timeCounter, &running);
+			if (LiveQueuePush(&queue, &running) != 0)
+			{
+				perror("realloc");
+				exit(1);
+			}
+		}
+		if (haveNext < 0)
+			break;
+	}
+	free(queue.items);
+	return haveNext < 0 ? -1 : 0;
+}
+
+/*
+ * @brief - admitStreamArrivals - queues every streamed process that arrives before a given time
+ *
+ * Inputs: *next, haveNext - the process read ahead from the stream and whether there is one, as returned by
+ 			                 readWorkloadStream - next is replaced by the following process as each one is queued
+ *
+ * Returns what readWorkloadStream returned for the process now in next.
+ */
+int admitStreamArrivals(struct_workload_stream *stream, struct_live_queue *queue, struct_process_info *next, int haveNext,
+                        int beforeTime, const struct_sim_config *config)
+{
+	while (haveNext > 0 && next->arriveTime < beforeTime)
+	{
+		if (next->remainingTime == 0) //a process with no burst time is completed as soon as it arrives
+			completeProcess(next, next->arriveTime, config->stats);
+		else if (LiveQueuePush(queue, next) != 0)
+		{
+			perror("realloc");
+			exit(1);
+		}
+		haveNext = readWorkloadStream(stream, next);
+	}
+	return haveNext;
+}
+
+/*
+ * @brief - averageWaitTime - adds all the wait times from the processes and calculates the average wait time
+ *
+ * Inputs: *processes - pointer to an array of processes - in which the function accesses the wait times of each process in the array
+ 			arraySize - size of the array - as the array size cannot be passed down from a pointer
+ *
+ */
+double averageWaitTime(struct_process_info *processes, int arraySize)
+{
+	long long totalWaitTime = 0; //64 bits so that large workloads do not overflow
+	int elementIndex;
+	for (elementIndex = 0; elementIndex < arraySize; elementIndex++)
+		totalWaitTime += processes[elementIndex].waitTime;
+	return (double)totalWaitTime / arraySize;
+}
+
+/*
+ * @brief - averageTurnAroundTime - adds all the turnaround times from the processes and calculates the average turnaround time
+ *
+ * Inputs: *processes - pointer to an array of processes - in which the function accesses the turnaround times of each process in the array
+ 			arraySize - size of the array - as the array size cannot be passed down from a pointer
+ *
+ */
+double averageTurnAroundTime(struct_process_info *processes, int arraySize)
+{
+	long long totalTurnAroundTime = 0;
+	int elementIndex;
+	for (elementIndex = 0; elementIndex < arraySize; elementIndex++)
+		totalTurnAroundTime += processes[elementIndex].turnAroundTime;
+	return (double)totalTurnAroundTime / arraySize;
+}
+
+/*
+ * @brief - ConstructProcessTable - creates a process table with room for count processes
+ *
+ * Every array is in one block of memory and starts on its own cache line. Returns NULL if there is not enough memory.
+ */
+struct_process_table *ConstructProcessTable(int count)
+{
+	struct_process_table *table = (struct_process_table*) malloc(sizeof (struct_process_table));
+	size_t stride = ((size_t) (count > 0 ? count : 1) * sizeof (int) + CACHE_LINE - 1) / CACHE_LINE * CACHE_LINE;
+	void *memory;
+
+	if (table == NULL)
+		return NULL;
+	if (posix_memalign(&memory, CACHE_LINE, stride * 7) != 0)
+	{
+		free(table);
+		return NULL;
+	}
+	table->count = count;
+	table->processId = (int*) memory;
+	table->arriveTime = (int*) ((char*) memory + stride);
+	table->burstTime = (int*) ((char*) memory + stride * 2);
+	table->remainingTime = (int*) ((char*) memory + stride * 3);
+	table->waitTime = (int*) ((char*) memory + stride * 4);
+	table->turnAroundTime = (int*) ((char*) memory + stride * 5);
+	table->priority = (int*) ((char*) memory + stride * 6);
+	return table;
+}
+
+void DestructProcessTable(struct_process_table *table)
+{
+	free(table->processId); //the start of the block holding every array
+	free(table);
+}
+
+/*
+ * @brief - processTableFromArray - copies table->count processes into a process table, one field at a time
+ */
+void processTableFromArray(struct_process_table *table, const struct_process_info *processes)
+{
+	int index;
+	for (index = 0; index < table->count; index++)
+	{
+		table->processId[index] = processes[index].processId;
+		table->arriveTime[index] = processes[index].arriveTime;
+		table->burstTime[index] = processes[index].burstTime;
+		table->remainingTime[index] = processes[index].remainingTime;
+		table->waitTime[index] = processes[index].waitTime;
+		table->turnAroundTime[index] = processes[index].turnAroundTime;
+		table->priority[index] = processes[index].priority;
+	}
+}
+
+/*
+ * @brief - processTableToArray - copies the processes of a table back into an array of table->count processes
+ */
+void processTableToArray(const struct_process_table *table, struct_process_info *processes)
+{
+	int index;
+	for (index = 0; index < table->count; index++)
+		processTableEntry(table, index, &processes[index]);
+}
+
+/*
+ * @brief - processTableEntry - gathers the fields of one process of a table into a struct_process_info
+ */
+void processTableEntry(const struct_process_table *table, int index, struct_process_info *process)
+{
+	process->processId = table->processId[index];
+	process->arriveTime = table->arriveTime[index];
+	process->burstTime = table->burstTime[index];
+	process->remainingTime = table->remainingTime[index];
+	process->waitTime = table->waitTime[index];
+	process->turnAroundTime = table->turnAroundTime[index];
+	process->priority = table->priority[index];
+}
+
+/*
+ * @brief - scheduleRoundRobinTable - the event driven round robin schedule over a process table sorted by arrive time
+ *
+ * Inputs: *table - the processes, sorted by arrive time - the wait and turnaround times are written into the table
+ 			*config - the same as scheduleRoundRobin
+ *
+ * The processes are admitted through a cursor over the sorted table, so the cost grows with the number of context
+ * switches rather than with the elapsed time. Arrivals are queued in the same order as the tick loop: a process that
+ * arrives while another is running is queued before the running process is requeued, while one that arrives at the
+ * exact moment the quantum expires is queued after it.
+ *
+ * The ready queue is a ring of indices into the table. Admitting arrivals only reads the arrive and remaining times,
+ * and running a process only the remaining time, so the other fields stay out of the cache until the process
+ * completes. A process is only gathered into a struct_process_info when there is a trace function to give it to,
+ * or statistics to add it to when it completes.
+ */
+void scheduleRoundRobinTable(struct_process_table *table, const struct_sim_config *config)
+{
+	int *arriveTime = table->arriveTime, *remainingTime = table->remainingTime;
+	int arraySize = table->count;
+	int *ring; //indices of the waiting processes, in queue order from first
+	int first = 0, size = 0; //position of the front of the queue in ring and the number of processes in it
+	int timeCounter, runTime, index, slot;
+	int flag = 0; //number of completed processes
+	int nextArrival = 0; //index of the first process that has not arrived yet
+	int lastRan = -1; //id of the process that ran last
+	int report = config->trace != NULL; //the trace function is given every field of the process
+	int dispatched = config->stats != NULL || config->switchCost != 0 || config->dispatchLatency != 0; //only the id is needed
+	struct_process_info process; //the process passed to the statistics and the trace function
+
+	if (arraySize <= 0)
+		return;
+	if ((ring = (int*) malloc(sizeof (int) * arraySize)) == NULL)
+	{
+		perror("malloc");
+		exit(1);
+	}
+	timeCounter = arriveTime[0];
+
+	while (flag < arraySize)
+	{
+		flag += admitTableArrivals(table, ring, first, &size, &nextArrival, timeCounter + 1, config->stats); //admit every process that has arrived
+		if (size == 0) //the CPU is idle - jump straight to the next arrival
+		{
+			if (nextArrival >= arraySize)
+				break;
+			timeCounter = arriveTime[nextArrival];
+			continue;
+		}
+
+		index = ring[first];
+		runTime = remainingTime[index];
+		if (config->timeQuantum > 0 && runTime > config->timeQuantum)
+			runTime = config->timeQuantum;
+		if (report)
+		{
+			processTableEntry(table, index, &process);
+			timeCounter += dispatchOverhead(config, &process, &lastRan);
+			traceEvent(config, TRACE_DISPATCH, timeCounter, &process);
+		}
+		else if (dispatched)
+		{
+			process.processId = table->processId[index];
+			timeCounter += dispatchOverhead(config, &process, &lastRan);
+		}
+		timeCounter += runTime; //run the process until it completes or the time quantum expires
+		remainingTime[index] -= runTime;
+
+		flag += admitTableArrivals(table, ring, first, &size, &nextArrival, timeCounter, config->stats); //processes that arrived while it was running
+
+		first = first + 1 < arraySize ? first + 1 : 0; //take the process off the front of the queue
+		size--;
+		if (remainingTime[index] == 0) //the process is completed
+		{
+			table->turnAroundTime[index] = timeCounter - arriveTime[index];
+			table->waitTime[index] = table->turnAroundTime[index] - table->burstTime[index];
+			if (report || config->stats != NULL)
+			{
+				if (report)
+					processTableEntry(table, index, &process);
+				else //the statistics only read the times, which are already in the cache
+				{
+					process.arriveTime = arriveTime[index];
+					process.burstTime = table->burstTime[index];
+					process.waitTime = table->waitTime[index];
+					process.turnAroundTime = table->turnAroundTime[index];
+				}
+				if (config->stats != NULL)
+					recordCompletion(config->stats, &process, timeCounter);
+				traceEvent(config, TRACE_COMPLETE, timeCounter, &process);
+			}
+			flag++;
+		}
+		else //the time quantum expired, requeue the process behind the arrivals
+		{
+			if (report)
+			{
+				processTableEntry(table, index, &process);
+				preemptProcess(config, timeCounter, &process);
+			}
+			else if (config->stats != NULL)
+				config->stats->preemptions++;
+			slot = first + size++;
+			ring[slot < arraySize ? slot : slot - arraySize] = index;
+		}
+	}
+	free(ring);
+}
+
+/*
+ * @brief - admitTableArrivals - adds every process of a table that arrives before a given time to a ring of indices
+ *
+ * Inputs: *ring, first, *size - the ready queue of scheduleRoundRobinTable, with room for every process of the table
+ 			*nextArrival, beforeTime, *stats - the same as admitArrivals
+ *
+ * The arrivals are found by reading only the arrive times, then queued by reading only their remaining times.
+ * Returns the number of processes that were completed on arrival because they have no burst time.
+ */
+int admitTableArrivals(struct_process_table *table, int *ring, int first, int *size, int *nextArrival, int beforeTime,
+                       struct_sim_stats *stats)
+{
+	struct_process_info process;
+	int index, last, slot, completed = 0;
+
+	for (last = *nextArrival; last < table->count && table->arriveTime[last] < beforeTime; last++)
+		;
+	for (index = *nextArrival; index < last; index++)
+	{
+		if (table->remainingTime[index] != 0)
+		{
+			slot = first + (*size)++; //first and size are both below the count, so one subtraction wraps the slot
+			ring[slot < table->count ? slot : slot - table->count] = index;
+		}
+		else //a process with no burst time is completed as soon as it arrives
+		{
+			table->turnAroundTime[index] = 0;
+			table->waitTime[index] = 0;
+			if (stats != NULL)
+			{
+				processTableEntry(table, index, &process);
+				recordCompletion(stats, &process, process.arriveTime);
+			}
+			completed++;
+		}
+	}
+	*nextArrival = last;
+	return completed;
+}
+
+/*
+ * @brief - sumOfTimes - adds up an array of times - a plain loop over contiguous ints, which the compiler vectorizes
+ */
+long long sumOfTimes(const int *times, int count)
+{
+	long long total = 0;
+	int index;
+	for (index = 0; index < count; index++)
+		total += times[index];
+	return total;
+}
+
+/*
+ * @brief - averageWaitTimeTable - averageWaitTime over a process table, reading only the wait times
+ */
+double averageWaitTimeTable(const struct_process_table *table)
+{
+	return (double) sumOfTimes(table->waitTime, table->count) / table->count;
+}
+
+/*
+ * @brief - averageTurnAroundTimeTable - averageTurnAroundTime over a process table, reading only the turnaround times
+ */
+double averageTurnAroundTimeTable(const struct_process_table *table)
+{
+	return (double) sumOfTimes(table->turnAroundTime, table->count) / table->count;
+}
+
+/*
+ * @brief - summariseProcessTable - summariseResults over the burst, wait and turnaround times of a process table
+ */
+void summariseProcessTable(const struct_process_table *table, struct_result_summary *summary)
+{
+	summariseResults(table->burstTime, table->waitTime, table->turnAroundTime, table->count, summary);
+}
+
+/* ************************ End of Methods and functions for using Round robin **************************** */
+
+
+
+
+
+/* ************************ Methods and functions for collecting statistics **************************** */
+void initialiseStats(struct_sim_stats *stats)
+{
+	memset(stats, 0, sizeof (struct_sim_stats));
+	stats->firstArrival = INT_MAX;
+	stats->lastCompletion = INT_MIN;
+	stats->numOfCores = 1;
+}
+
+/*
+ * @brief - recordCompletion - adds a completed process to the statistics
+ *
+ * Inputs: *stats - the statistics to add to
+ 			*process - the completed process with its wait time and turnaround time filled in
+ 			completionTime - the time the process completed
+ *
+ * Only constant work is done per process: the sums are 64 bits, the mean and variance are kept with Welford's
+ * method and the percentiles come from adding one to a histogram bucket.
+ */
+void recordCompletion(struct_sim_stats *stats, struct_process_info *process, int completionTime)
+{
+	double delta;
+
+	stats->count++;
+	stats->totalWaitTime += process->waitTime;
+	stats->totalTurnAroundTime += process->turnAroundTime;
+	stats->busyTime += process->burstTime;
+
+	delta = process->waitTime - stats->meanWaitTime;
+	stats->meanWaitTime += delta / stats->count;
+	stats->m2WaitTime += delta * (process->waitTime - stats->meanWaitTime);
+	delta = process->turnAroundTime - stats->meanTurnAroundTime;
+	stats->meanTurnAroundTime += delta / stats->count;
+	stats->m2TurnAroundTime += delta * (process->turnAroundTime - stats->meanTurnAroundTime);
+
+	if (process->arriveTime < stats->firstArrival)
+		stats->firstArrival = process->arriveTime;
+	if (completionTime > stats->lastCompletion)
+		stats->lastCompletion = completionTime;
+	stats->waitHistogram[histogramBucket(process->waitTime)]++;
+	stats->turnAroundHistogram[histogramBucket(process->turnAroundTime)]++;
+}
+
+/*
+ * @brief - mergeStats - adds the statistics of part to total, as if every process of part had been recorded in total
+ */
+void mergeStats(struct_sim_stats *total, const struct_sim_stats *part)
+{
+	double delta;
+	long long count = total->count + part->count;
+	int index;
+
+	if (part->count == 0)
+		return;
+	delta = part->meanWaitTime - total->meanWaitTime; //Chan et al. combination of two Welford accumulators
+	total->m2WaitTime += part->m2WaitTime + delta * delta * total->count * part->count / count;
+	total->meanWaitTime += delta * part->count / count;
+	delta = part->meanTurnAroundTime - total->meanTurnAroundTime;
+	total->m2TurnAroundTime += part->m2TurnAroundTime + delta * delta * total->count * part->count / count;
+	total->meanTurnAroundTime += delta * part->count / count;
+
+	total->count = count;
+	total->totalWaitTime += part->totalWaitTime;
+	total->totalTurnAroundTime += part->totalTurnAroundTime;
+	total->busyTime += part->busyTime;
+	total->overheadTime += part->overheadTime;
+	total->dispatches += part->dispatches;
+	total->contextSwitches += part->contextSwitches;
+	total->preemptions += part->preemptions;
+	if (part->firstArrival < total->firstArrival)
+		total->firstArrival = part->firstArrival;
+	if (part->lastCompletion > total->lastCompletion)
+		total->lastCompletion = part->lastCompletion;
+	for (index = 0; index < HISTOGRAM_BUCKETS; index++)
+	{
+		total->waitHistogram[index] += part->waitHistogram[index];
+		total->turnAroundHistogram[index] += part->turnAroundHistogram[index];
+	}
+}
+
+/*
+ * @brief - histogramBucket - the histogram bucket a non-negative value is counted in
+ */
+int histogramBucket(int value)
+{
+	int exponent;
+	if (value < (1 << HISTOGRAM_PRECISION_BITS)) //small values have a bucket each
+		return value < 0 ? 0 : value;
+	exponent = 31 - __builtin_clz(value); //the power of two the value is in
+	return (1 << HISTOGRAM_PRECISION_BITS) + (exponent - HISTOGRAM_PRECISION_BITS) * (1 << (HISTOGRAM_PRECISION_BITS - 1)) +
+	       ((value >> (exponent - HISTOGRAM_PRECISION_BITS + 1)) - (1 << (HISTOGRAM_PRECISION_BITS - 1)));
+}
+
+/*
+ * @brief - histogramBucketValue - the value reported for a bucket - the middle of the values counted in it
+ */
+int histogramBucketValue(int bucket)
+{
+	int exponent, subBucket, shift;
+	if (bucket < (1 << HISTOGRAM_PRECISION_BITS))
+		return bucket;
+	bucket -= 1 << HISTOGRAM_PRECISION_BITS;
+	exponent = bucket / (1 << (HISTOGRAM_PRECISION_BITS - 1)) + HISTOGRAM_PRECISION_BITS;
+	subBucket = bucket % (1 << (HISTOGRAM_PRECISION_BITS - 1)) + (1 << (HISTOGRAM_PRECISION_BITS - 1));
+	shift = exponent - HISTOGRAM_PRECISION_BITS + 1;
+	return (int) (((long long) subBucket << shift) + ((1LL << shift) - 1) / 2);
+}
+
+/*
+ * @brief - statsQuantile - the value below which the given fraction (0 to 1) of the counted values lie
+ */
+int statsQuantile(const long long *histogram, long long count, double quantile)
+{
+	long long rank, seen = 0;
+	int bucket;
+
+	if (count == 0)
+		return 0;
+	rank = (long long) ceil(quantile * count); //the rank-th smallest value, counting from 1
+	if (rank < 1)
+		rank = 1;
+	for (bucket = 0; bucket < HISTOGRAM_BUCKETS; bucket++)
+	{
+		seen += histogram[bucket];
+		if (seen >= rank)
+			return histogramBucketValue(bucket);
+	}
+	return histogramBucketValue(HISTOGRAM_BUCKETS - 1);
+}
+
+double statsStdDev(double m2, long long count)
+{
+	return count > 0 ? sqrt(m2 / count) : 0;
+}
+
+/*
+ * @brief - formatStats - writes the statistics as the text that goes into the output file
+ *
+ * The first two lines are the average wait time and turnaround time in the original format. The CPU utilisation
+ * counts the time spent switching between processes, the effective utilisation only the time spent running them.
+ * Returns the number of characters written, like snprintf.
+ */
+int formatStats(char *buffer, size_t length, const struct_sim_stats *stats)
+{
+	long long elapsed = (long long) stats->lastCompletion - stats->firstArrival; //time from the first arrival to the last completion
+	double count = stats->count > 0 ? stats->count : 1;
+	double capacity; //time the CPUs were available
+
+	if (stats->count == 0 || elapsed <= 0)
+		elapsed = 0;
+	capacity = (double) elapsed * stats->numOfCores;
+	return snprintf(buffer, length,
+	                "Average Wait Time: %lf \nAverage Turnaround Time: %lf \n"
+	                "Wait Time Std Dev: %lf, p50: %d, p95: %d, p99: %d \n"
+	                "Turnaround Time Std Dev: %lf, p50: %d, p95: %d, p99: %d \n"
+	                "Throughput: %lf processes per time unit \nCPU Utilisation: %.2lf%% \n"
+	                "Dispatches: %lld, Context Switches: %lld, Preemptions: %lld \n"
+	                "Switch Overhead: %lld time units, Effective CPU Utilisation: %.2lf%% \n",
+	                stats->totalWaitTime / count, stats->totalTurnAroundTime / count,
+	                statsStdDev(stats->m2WaitTime, stats->count), statsQuantile(stats->waitHistogram, stats->count, 0.50),
+	                statsQuantile(stats->waitHistogram, stats->count, 0.95), statsQuantile(stats->waitHistogram, stats->count, 0.99),
+	                statsStdDev(stats->m2TurnAroundTime, stats->count), statsQuantile(stats->turnAroundHistogram, stats->count, 0.50),
+	                statsQuantile(stats->turnAroundHistogram, stats->count, 0.95),
+	                statsQuantile(stats->turnAroundHistogram, stats->count, 0.99),
+	                elapsed > 0 ? stats->count / (double) elapsed : 0,
+	                elapsed > 0 ? 100.0 * (stats->busyTime + stats->overheadTime) / capacity : 0,
+	                stats->dispatches, stats->contextSwitches, stats->preemptions, stats->overheadTime,
+	                elapsed > 0 ? 100.0 * stats->busyTime / capacity : 0);
+}
+
+/*
+ * @brief - formatCoreStats - writes the results of one core of a multi-core simulation as a line of text
+ */
+int formatCoreStats(char *buffer, size_t length, const struct_core_stats *coreStats, int core, const struct_sim_stats *stats)
+{
+	long long elapsed = (long long) stats->lastCompletion - stats->firstArrival;
+
+	return snprintf(buffer, length, "Core %d: Utilisation: %.2lf%%, Dispatches: %lld, Migrations: %lld, Steals: %lld \n", core,
+	                elapsed > 0 ? 100.0 * coreStats->busyTime / elapsed : 0, coreStats->dispatches, coreStats->migrations,
+	                coreStats->steals);
+}
+/* ************************ End of Methods and functions for collecting statistics **************************** */
+
+
+
+
+
+/* ************************ Methods and functions for summarising results **************************** */
+/*
+ * @brief - summariseResults - sums, extremes, histograms and consistency checks of the results of a schedule
+ *
+ * Inputs: *burstTime, *waitTime, *turnAroundTime - the results of count processes, one array per field, such as the
+ 			                                        arrays of a struct_process_table
+ 			*summary - filled in with the results
+ *
+ * Everything is found in one pass over the three arrays by the fastest kernel of resultKernels the CPU supports,
+ * which is chosen the first time. Every kernel works in integers only, so they all give exactly the same summary.
+ */
+void summariseResults(const int *burstTime, const int *waitTime, const int *turnAroundTime, long long count,
+                      struct_result_summary *summary)
+{
+	static const struct_result_kernel *_Atomic chosen = NULL; //threads that race to choose all store the same kernel
+	const struct_result_kernel *kernel = atomic_load_explicit(&chosen, memory_order_acquire);
+
+	if (kernel == NULL)
+	{
+		kernel = chooseResultKernel();
+		atomic_store_explicit(&chosen, kernel, memory_order_release);
+	}
+	kernel->run(burstTime, waitTime, turnAroundTime, count, summary);
+}
+
+/*
+ * @brief - chooseResultKernel - the first kernel of resultKernels that the CPU supports - the last one always is
+ */
+const struct_result_kernel *chooseResultKernel(void)
+{
+	const struct_result_kernel *kernel;
+	for (kernel = resultKernels; kernel[1].name != NULL; kernel++)
+		if (kernel->supported())
+			break;
+	return kernel;
+}
+
+void initialiseResultSummary(struct_result_summary *summary)
+{
+	memset(summary, 0, sizeof (struct_result_summary));
+	summary->minWaitTime = summary->minTurnAroundTime = INT_MAX;
+	summary->maxWaitTime = summary->maxTurnAroundTime = INT_MIN;
+}
+
+/*
+ * @brief - summariseResultsRange - adds processes from index first up to count to a summary, one at a time
+ *
+ * The scalar kernel, and the end of the arrays that is too short for a vector in the others.
+ */
+void summariseResultsRange(const int *burstTime, const int *waitTime, const int *turnAroundTime, long long first,
+                           long long count, struct_result_summary *summary)
+{
+	long long index;
+	int burst, wait, turnAround;
+
+	for (index = first; index < count; index++)
+	{
+		burst = burstTime[index];
+		wait = waitTime[index];
+		turnAround = turnAroundTime[index];
+		summary->totalBurstTime += burst;
+		summary->totalWaitTime += wait;
+		summary->totalTurnAroundTime += turnAround;
+		if (wait < summary->minWaitTime)
+			summary->minWaitTime = wait;
+		if (wait > summary->maxWaitTime)
+			summary->maxWaitTime = wait;
+		if (turnAround < summary->minTurnAroundTime)
+			summary->minTurnAroundTime = turnAround;
+		if (turnAround > summary->maxTurnAroundTime)
+			summary->maxTurnAroundTime = turnAround;
+		summary->badWaitTimes += (unsigned int) wait != (unsigned int) turnAround - (unsigned int) burst; //wraps like the vector kernels
+		summary->badTurnAroundTimes += turnAround < burst;
+		summary->waitHistogram[histogramBucket(wait)]++;
+		summary->turnAroundHistogram[histogramBucket(turnAround)]++;
+	}
+	summary->count += count > first ? count - first : 0;
+}
+
+void summariseResultsScalar(const int *burstTime, const int *waitTime, const int *turnAroundTime, long long count,
+                            struct_result_summary *summary)
+{
+	initialiseResultSummary(summary);
+	summariseResultsRange(burstTime, waitTime, turnAroundTime, 0, count, summary);
+}
+
+int resultKernelAlwaysSupported(void)
+{
+	return 1;
+}
+
+#if defined(__x86_64__) || defined(__i386__)
+/*
+ * The histogram bucket of a value of 2^HISTOGRAM_PRECISION_BITS or more comes from its conversion to a double, which is
+ * exact for every int: the exponent is the power of two the value is in and the top mantissa bits are the bits after
+ * its leading one, so shifting the bits of the double right by HISTOGRAM_DOUBLE_SHIFT leaves the bucket plus
+ * HISTOGRAM_DOUBLE_BIAS - the same bucket as histogramBucket without counting leading zeros.
+ */
+#define HISTOGRAM_DOUBLE_SHIFT (53 - HISTOGRAM_PRECISION_BITS)
+#define HISTOGRAM_DOUBLE_BIAS ((1023 + HISTOGRAM_PRECISION_BITS) * (1 << (HISTOGRAM_PRECISION_BITS - 1)) - (1 << HISTOGRAM_PRECISION_BITS))
+
+int resultKernelSSE41Supported(void)
+{
+	return __builtin_cpu_supports("sse4.1");
+}
+
+int resultKernelAVX2Supported(void)
+{
+	return __builtin_cpu_supports("avx2");
+}
+
+/*
+ * @brief - histogramBuckets2 - the histogram buckets of the low two ints of a vector, as two 64-bit lanes
+ */
+__attribute__((target("sse4.1")))
+static inline __m128i histogramBuckets2(__m128i values)
+{
+	__m128i large = _mm_sub_epi64(_mm_srli_epi64(_mm_castpd_si128(_mm_cvtepi32_pd(values)), HISTOGRAM_DOUBLE_SHIFT),
+	                              _mm_set1_epi64x(HISTOGRAM_DOUBLE_BIAS));
+	__m128i small = _mm_cvtepi32_epi64(_mm_max_epi32(values, _mm_setzero_si128())); //negative values count as 0
+	__m128i isSmall = _mm_cvtepi32_epi64(_mm_cmplt_epi32(values, _mm_set1_epi32(1 << HISTOGRAM_PRECISION_BITS)));
+	return _mm_blendv_epi8(large, small, isSmall);
+}
+
+__attribute__((target("sse4.1")))
+void summariseResultsSSE41(const int *burstTime, const int *waitTime, const int *turnAroundTime, long long count,
+                           struct_result_summary *summary)
+{
+	__m128i burstSum = _mm_setzero_si128(), waitSum = _mm_setzero_si128(), turnAroundSum = _mm_setzero_si128();
+	__m128i minWait = _mm_set1_epi32(INT_MAX), maxWait = _mm_set1_epi32(INT_MIN);
+	__m128i minTurnAround = _mm_set1_epi32(INT_MAX), maxTurnAround = _mm_set1_epi32(INT_MIN);
+	__m128i burst, wait, turnAround;
+	long long index, vectorEnd = count - count % 4, badWait = 0, badTurnAround = 0;
+	int64_t buckets[4], lanes[2];
+	int lane;
+
+	initialiseResultSummary(summary);
+	for (index = 0; index < vectorEnd; index += 4)
+	{
+		burst = _mm_loadu_si128((const __m128i*) (burstTime + index));
+		wait = _mm_loadu_si128((const __m128i*) (waitTime + index));
+		turnAround = _mm_loadu_si128((const __m128i*) (turnAroundTime + index));
+		burstSum = _mm_add_epi64(_mm_add_epi64(burstSum, _mm_cvtepi32_epi64(burst)), _mm_cvtepi32_epi64(_mm_srli_si128(burst, 8)));
+		waitSum = _mm_add_epi64(_mm_add_epi64(waitSum, _mm_cvtepi32_epi64(wait)), _mm_cvtepi32_epi64(_mm_srli_si128(wait, 8)));
+		turnAroundSum = _mm_add_epi64(_mm_add_epi64(turnAroundSum, _mm_cvtepi32_epi64(turnAround)),
+		                              _mm_cvtepi32_epi64(_mm_srli_si128(turnAround, 8)));
+		minWait = _mm_min_epi32(minWait, wait);
+		maxWait = _mm_max_epi32(maxWait, wait);
+		minTurnAround = _mm_min_epi32(minTurnAround, turnAround);
+		maxTurnAround = _mm_max_epi32(maxTurnAround, turnAround);
+		badWait += 4 - __builtin_popcount(_mm_movemask_ps(_mm_castsi128_ps(_mm_cmpeq_epi32(wait, _mm_sub_epi32(turnAround, burst)))));
+		badTurnAround += __builtin_popcount(_mm_movemask_ps(_mm_castsi128_ps(_mm_cmplt_epi32(turnAround, burst))));
+
+		_mm_storeu_si128((__m128i*) buckets, histogramBuckets2(wait));
+		_mm_storeu_si128((__m128i*) (buckets + 2), histogramBuckets2(_mm_srli_si128(wait, 8)));
+		for (lane = 0; lane < 4; lane++)
+			summary->waitHistogram[buckets[lane]]++;
+		_mm_storeu_si128((__m128i*) buckets, histogramBuckets2(turnAround));
+		_mm_storeu_si128((__m128i*) (buckets + 2), histogramBuckets2(_mm_srli_si128(turnAround, 8)));
+		for (lane = 0; lane < 4; lane++)
+			summary->turnAroundHistogram[buckets[lane]]++;
+	}
+
+	_mm_storeu_si128((__m128i*) lanes, burstSum);
+	summary->totalBurstTime = lanes[0] + lanes[1];
+	_mm_storeu_si128((__m128i*) lanes, waitSum);
+	summary->totalWaitTime = lanes[0] + lanes[1];
+	_mm_storeu_si128((__m128i*) lanes, turnAroundSum);
+	summary->totalTurnAroundTime = lanes[0] + lanes[1];
+	minWait = _mm_min_epi32(minWait, _mm_srli_si128(minWait, 8)); //fold the four lanes into lane 0
+	summary->minWaitTime = _mm_cvtsi128_si32(_mm_min_epi32(minWait, _mm_srli_si128(minWait, 4)));
+	maxWait = _mm_max_epi32(maxWait, _mm_srli_si128(maxWait, 8));
+	summary->maxWaitTime = _mm_cvtsi128_si32(_mm_max_epi32(maxWait, _mm_srli_si128(maxWait, 4)));
+	minTurnAround = _mm_min_epi32(minTurnAround, _mm_srli_si128(minTurnAround, 8));
+	summary->minTurnAroundTime = _mm_cvtsi128_si32(_mm_min_epi32(minTurnAround, _mm_srli_si128(minTurnAround, 4)));
+	maxTurnAround = _mm_max_epi32(maxTurnAround, _mm_srli_si128(maxTurnAround, 8));
+	summary->maxTurnAroundTime = _mm_cvtsi128_si32(_mm_max_epi32(maxTurnAround, _mm_srli_si128(maxTurnAround, 4)));
+	summary->badWaitTimes = badWait;
+	summary->badTurnAroundTimes = badTurnAround;
+	summary->count = vectorEnd;
+	summariseResultsRange(burstTime, waitTime, turnAroundTime, vectorEnd, count, summary);
+}
+
+/*
+ * @brief - histogramBuckets4 - the histogram buckets of four ints, as four 64-bit lanes
+ */
+__attribute__((target("avx2")))
+static inline __m256i histogramBuckets4(__m128i values)
+{
+	__m256i large = _mm256_sub_epi64(_mm256_srli_epi64(_mm256_castpd_si256(_mm256_cvtepi32_pd(values)), HISTOGRAM_DOUBLE_SHIFT),
+	                                 _mm256_set1_epi64x(HISTOGRAM_DOUBLE_BIAS));
+	__m256i small = _mm256_cvtepi32_epi64(_mm_max_epi32(values, _mm_setzero_si128()));
+	__m256i isSmall = _mm256_cvtepi32_epi64(_mm_cmplt_epi32(values, _mm_set1_epi32(1 << HISTOGRAM_PRECISION_BITS)));
+	return _mm256_blendv_epi8(large, small, isSmall);
+}
+
+__attribute__((target("avx2")))
+void summariseResultsAVX2(const int *burstTime, const int *waitTime, const int *turnAroundTime, long long count,
+                          struct_result_summary *summary)
+{
+	__m256i burstSum = _mm256_setzero_si256(), waitSum = _mm256_setzero_si256(), turnAroundSum = _mm256_setzero_si256();
+	__m256i minWait = _mm256_set1_epi32(INT_MAX), maxWait = _mm256_set1_epi32(INT_MIN);
+	__m256i minTurnAround = _mm256_set1_epi32(INT_MAX), maxTurnAround = _mm256_set1_epi32(INT_MIN);
+	__m256i burst, wait, turnAround;
+	__m128i low, high;
+	long long index, vectorEnd = count - count % 8, badWait = 0, badTurnAround = 0;
+	int64_t buckets[8], lanes[4];
+	int32_t extremes[8];
+	int lane;
+
+	initialiseResultSummary(summary);
+	for (index = 0; index < vectorEnd; index += 8)
+	{
+		burst = _mm256_loadu_si256((const __m256i*) (burstTime + index));
+		wait = _mm256_loadu_si256((const __m256i*) (waitTime + index));
+		turnAround = _mm256_loadu_si256((const __m256i*) (turnAroundTime + index));
+		burstSum = _mm256_add_epi64(_mm256_add_epi64(burstSum, _mm256_cvtepi32_epi64(_mm256_castsi256_si128(burst))),
+		                            _mm256_cvtepi32_epi64(_mm256_extracti128_si256(burst, 1)));
+		waitSum = _mm256_add_epi64(_mm256_add_epi64(waitSum, _mm256_cvtepi32_epi64(_mm256_castsi256_si128(wait))),
+		                           _mm256_cvtepi32_epi64(_mm256_extracti128_si256(wait, 1)));
+		turnAroundSum = _mm256_add_epi64(_mm256_add_epi64(turnAroundSum, _mm256_cvtepi32_epi64(_mm256_castsi256_si128(turnAround))),
+		                                 _mm256_cvtepi32_epi64(_mm256_extracti128_si256(turnAround, 1)));
+		minWait = _mm256_min_epi32(minWait, wait);
+		maxWait = _mm256_max_epi32(maxWait, wait);
+		minTurnAround = _mm256_min_epi32(minTurnAround, turnAround);
+		maxTurnAround = _mm256_max_epi32(maxTurnAround, turnAround);
+		badWait += 8 - __builtin_popcount(_mm256_movemask_ps(_mm256_castsi256_ps(
+		                                      _mm256_cmpeq_epi32(wait, _mm256_sub_epi32(turnAround, burst)))));
+		badTurnAround += __builtin_popcount(_mm256_movemask_ps(_mm256_castsi256_ps(_mm256_cmpgt_epi32(burst, turnAround))));
+
+		low = _mm256_castsi256_si128(wait);
+		high = _mm256_extracti128_si256(wait, 1);
+		_mm256_storeu_si256((__m256i*) buckets, histogramBuckets4(low));
+		_mm256_storeu_si256((__m256i*) (buckets + 4), histogramBuckets4(high));
+		for (lane = 0; lane < 8; lane++)
+			summary->waitHistogram[buckets[lane]]++;
+		low = _mm256_castsi256_si128(turnAround);
+		high = _mm256_extracti128_si256(turnAround, 1);
+		_mm256_storeu_si256((__m256i*) buckets, histogramBuckets4(low));
+		_mm256_storeu_si256((__m256i*) (buckets + 4), histogramBuckets4(high));
+		for (lane = 0; lane < 8; lane++)
+			summary->turnAroundHistogram[buckets[lane]]++;
+	}
+
+	_mm256_storeu_si256((__m256i*) lanes, burstSum);
+	summary->totalBurstTime = lanes[0] + lanes[1] + lanes[2] + lanes[3];
+	_mm256_storeu_si256((__m256i*) lanes, waitSum);
+	summary->totalWaitTime = lanes[0] + lanes[1] + lanes[2] + lanes[3];
+	_mm256_storeu_si256((__m256i*) lanes, turnAroundSum);
+	summary->totalTurnAroundTime = lanes[0] + lanes[1] + lanes[2] + lanes[3];
+	_mm256_storeu_si256((__m256i*) extremes, minWait);
+	for (lane = 0; lane < 8; lane++)
+		if (extremes[lane] < summary->minWaitTime)
+			summary->minWaitTime = extremes[lane];
+	_mm256_storeu_si256((__m256i*) extremes, maxWait);
+	for (lane = 0; lane < 8; lane++)
+		if (extremes[lane] > summary->maxWaitTime)
+			summary->maxWaitTime = extremes[lane];
+	_mm256_storeu_si256((__m256i*) extremes, minTurnAround);
+	for (lane = 0; lane < 8; lane++)
+		if (extremes[lane] < summary->minTurnAroundTime)
+			summary->minTurnAroundTime = extremes[lane];
+	_mm256_storeu_si256((__m256i*) extremes, maxTurnAround);
+	for (lane = 0; lane < 8; lane++)
+		if (extremes[lane] > summary->maxTurnAroundTime)
+			summary->maxTurnAroundTime = extremes[lane];
+	summary->badWaitTimes = badWait;
+	summary->badTurnAroundTimes = badTurnAround;
+	summary->count = vectorEnd;
+	summariseResultsRange(burstTime, waitTime, turnAroundTime, vectorEnd, count, summary);
+}
+#endif
+
+/*
+ * @brief - resultSummaryText - writes a summary as text, with the percentiles read from its histograms
+ *
+ * Returns the number of characters written, like snprintf.
+ */
+int resultSummaryText(char *buffer, size_t length, const struct_result_summary *summary)
+{
+	double count = summary->count > 0 ? summary->count : 1;
+
+	return snprintf(buffer, length,
+	                "Processes: %lld, Average Wait Time: %lf, Average Turnaround Time: %lf \n"
+	                "Wait Time min: %d, p50: %d, p99: %d, max: %d \n"
+	                "Turnaround Time min: %d, p50: %d, p99: %d, max: %d \n"
+	                "Wait Time != Turnaround Time - Burst Time: %lld, Turnaround Time < Burst Time: %lld \n",
+	                summary->count, summary->totalWaitTime / count, summary->totalTurnAroundTime / count,
+	                summary->count > 0 ? summary->minWaitTime : 0, statsQuantile(summary->waitHistogram, summary->count, 0.50),
+	                statsQuantile(summary->waitHistogram, summary->count, 0.99), summary->count > 0 ? summary->maxWaitTime : 0,
+	                summary->count > 0 ? summary->minTurnAroundTime : 0,
+	                statsQuantile(summary->turnAroundHistogram, summary->count, 0.50),
+	                statsQuantile(summary->turnAroundHistogram, summary->count, 0.99),
+	                summary->count > 0 ? summary->maxTurnAroundTime : 0, summary->badWaitTimes, summary->badTurnAroundTimes);
+}
+/* ************************ End of Methods and functions for summarising results **************************** */
+
+
+
+
+
+/* ************************ Methods and functions for the other scheduling policies **************************** */
+/*
+ * @brief - findPolicy - looks up a scheduling policy by the name given with -p, NULL if there is none
+ */
+const struct_policy *findPolicy(const char *name)
+{
+	int index;
+	for (index = 0; policies[index].name != NULL; index++)
+		if (strcmp(policies[index].name, name) == 0)
+			return &policies[index];
+	return NULL;
+}
+
+/*
+ * @brief - completeProcess - calculates the turnaround time and wait time of a process that finished at timeCounter
+ *
+ * The process is added to stats straight away, so the statistics need no second pass over the processes.
+ */
+void completeProcess(struct_process_info *process, int timeCounter, struct_sim_stats *stats)
+{
+	process->remainingTime = 0;
+	process->turnAroundTime = timeCounter - process->arriveTime;
+	process->waitTime = process->turnAroundTime - process->burstTime;
+	if (stats != NULL)
+		recordCompletion(stats, process, timeCounter);
+}
+
+/*
+ * @brief - traceEvent - passes a dispatch, preemption or completion to the trace function of config, if it has one
+ */
+void traceEvent(const struct_sim_config *config, int event, int timeCounter, const struct_process_info *process)
+{
+	if (config->trace != NULL)
+		config->trace(config->traceContext, event, timeCounter, process);
+}
+
+/*
+ * @brief - preemptProcess - counts a process stopped before it completed and passes the preemption to the trace function
+ */
+void preemptProcess(const struct_sim_config *config, int timeCounter, const struct_process_info *process)
+{
+	if (config->stats != NULL)
+		config->stats->preemptions++;
+	traceEvent(config, TRACE_PREEMPT, timeCounter, process);
+}
+
+/*
+ * @brief - dispatchOverhead - the time the CPU spends before a dispatched process starts running
+ *
+ * Inputs: *config - the switch cost and dispatch latency, and the statistics the dispatch is counted in
+ 			*process - the process being dispatched
+ 			*lastRan - id of the process that ran last on the CPU, -1 for none - set to the id of process
+ *
+ * Every dispatch takes the dispatch latency, and a dispatch of a different process from the one that ran last also
+ * takes the switch cost. The policy adds the result to its time counter before the process runs, so the overhead
+ * counts as waiting time. Only a few additions are done per dispatch, so the totals are kept as the schedule runs.
+ */
+int dispatchOverhead(const struct_sim_config *config, const struct_process_info *process, int *lastRan)
+{
+	int switched = process->processId != *lastRan;
+	int overhead = config->dispatchLatency + (switched ? config->switchCost : 0);
+
+	*lastRan = process->processId;
+	if (config->stats != NULL)
+	{
+		config->stats->dispatches++;
+		config->stats->contextSwitches += switched;
+		config->stats->overheadTime += overhead;
+	}
+	return overhead;
+}
+
+/*
+ * @brief - scheduleRoundRobinTicks - runs the original tick-by-tick loop
+ */
+void scheduleRoundRobinTicks(struct_process_info *processes, int arraySize, const struct_sim_config *config)
+{
+	roundRobin(processes, arraySize, config);
+}
+
+/*
+ * @brief - firstComeFirstServed - runs every process to completion in the order they arrive
+ */
+void firstComeFirstServed(struct_process_info *processes, int arraySize, const struct_sim_config *config)
+{
+	int index;
+	int timeCounter = arraySize > 0 ? processes[0].arriveTime : 0;
+	int lastRan = -1;
+
+	for (index = 0; index < arraySize; index++)
+	{
+		if (timeCounter < processes[index].arriveTime) //the CPU is idle until the process arrives
+			timeCounter = processes[index].arriveTime;
+		if (processes[index].burstTime > 0) //a process with no burst time never runs
+		{
+			timeCounter += dispatchOverhead(config, &processes[index], &lastRan);
+			traceEvent(config, TRACE_DISPATCH, timeCounter, &processes[index]);
+		}
+		timeCounter += processes[index].burstTime;
+		completeProcess(&processes[index], timeCounter, config->stats);
+		if (processes[index].burstTime > 0)
+			traceEvent(config, TRACE_COMPLETE, timeCounter, &processes[index]);
+	}
+}
+
+/*
+ * @brief - admitArrivalsToHeap - pushes every process that arrives before a given time onto a heap
+ *
+ * Inputs: *heap - the ready heap the arriving processes are pushed onto
+ 			*processes, arraySize, *nextArrival, beforeTime - the same as admitArrivals
+ 			key - gives the key a process is ordered by in the heap
+ 			*config - passed to key
+ *
+ * Returns the number of processes that were completed on arrival because they have no burst time.
+ */
+int admitArrivalsToHeap(Heap *heap, struct_process_info *processes, int arraySize, int *nextArrival, int beforeTime,
+                        long long (*key)(struct_process_info *process, const struct_sim_config *config), const struct_sim_config *config)
+{
+	int completed = 0;
+
+	while (*nextArrival < arraySize && processes[*nextArrival].arriveTime < beforeTime)
+	{
+		if (processes[*nextArrival].remainingTime != 0)
+			HeapPush(heap, key(&processes[*nextArrival], config), *nextArrival);
+		else //a process with no burst time is completed as soon as it arrives
+		{
+			completeProcess(&processes[*nextArrival], processes[*nextArrival].arriveTime, config->stats);
+			completed++;
+		}
+		(*nextArrival)++;
+	}
+	return completed;
+}
+
+long long burstTimeKey(struct_process_info *process, const struct_sim_config *config)
+{
+	(void) config;
+	return process->burstTime;
+}
+
+long long remainingTimeKey(struct_process_info *process, const struct_sim_config *config)
+{
+	(void) config;
+	return process->remainingTime;
+}
+
+/*
+ * @brief - agedPriorityKey - orders waiting processes by priority, raised by one level every agingInterval time units waited
+ *
+ * At time t a process that arrived at a has the aged priority priority - (t - a) / agingInterval. Every waiting process
+ * ages at the same rate, so comparing aged priorities at any time gives the same order as comparing
+ * priority * agingInterval + a, which never changes and can stay in the heap. Without aging the arrive time only
+ * breaks ties between equal priorities.
+ */
+long long agedPriorityKey(struct_process_info *process, const struct_sim_config *config)
+{
+	if (config->agingInterval > 0)
+		return (long long) process->priority * config->agingInterval + process->arriveTime;
+	return (long long) process->priority * ((long long) INT_MAX + 1) + process->arriveTime;
+}
+
+/*
+ * @brief - runToCompletionFromHeap - shared loop of the non-preemptive heap policies (shortest job first and priority)
+ *
+ * Whenever the CPU is free the process with the smallest key is taken off the heap and run until it completes, so each
+ * decision costs O(log n).
+ */
+void runToCompletionFromHeap(struct_process_info *processes, int arraySize, const struct_sim_config *config,
+                             long long (*key)(struct_process_info *process, const struct_sim_config *config))
+{
+	int timeCounter;
+	int flag = 0; //number of completed processes
+	int nextArrival = 0; //index of the first process that has not arrived yet
+	struct_heap_item item;
+	int lastRan = -1;
+	Heap *heap;
+
+	if (arraySize <= 0)
+		return;
+	heap = ConstructHeap(arraySize);
+	timeCounter = processes[0].arriveTime;
+
+	while (flag < arraySize)
+	{
+		flag += admitArrivalsToHeap(heap, processes, arraySize, &nextArrival, timeCounter + 1, key, config);
+		if (heap->size == 0) //the CPU is idle - jump straight to the next arrival
+		{
+			if (nextArrival >= arraySize)
+				break;
+			timeCounter = processes[nextArrival].arriveTime;
+			continue;
+		}
+		item = HeapPop(heap);
+		timeCounter += dispatchOverhead(config, &processes[item.index], &lastRan);
+		traceEvent(config, TRACE_DISPATCH, timeCounter, &processes[item.index]);
+		timeCounter += processes[item.index].remainingTime; //run the process until it completes
+		completeProcess(&processes[item.index], timeCounter, config->stats);
+		traceEvent(config, TRACE_COMPLETE, timeCounter, &processes[item.index]);
+		flag++;
+	}
+	DestructHeap(heap);
+}
+
+/*
+ * @brief - shortestJobFirst - whenever the CPU is free, runs the waiting process with the shortest burst time to completion
+ */
+void shortestJobFirst(struct_process_info *processes, int arraySize, const struct_sim_config *config)
+{
+	runToCompletionFromHeap(processes, arraySize, config, burstTimeKey);
+}
+
+/*
+ * @brief - priorityScheduling - whenever the CPU is free, runs the waiting process with the lowest aged priority to completion
+ */
+void priorityScheduling(struct_process_info *processes, int arraySize, const struct_sim_config *config)
+{
+	runToCompletionFromHeap(processes, arraySize, config, agedPriorityKey);
+}
+
+/*
+ * @brief - shortestRemainingTimeFirst - always runs the process with the least remaining time, preempting on arrivals
+ *
+ * The running process stays on top of the heap. It runs until it completes or the next process arrives, whichever is
+ * first; its key only goes down while it runs, so it stays on top until an arrival with less remaining time is pushed.
+ * Equal remaining times do not preempt because the earlier arrival wins the tie.
+ */
+void shortestRemainingTimeFirst(struct_process_info *processes, int arraySize, const struct_sim_config *config)
+{
+	int timeCounter;
+	int flag = 0; //number of completed processes
+	int nextArrival = 0; //index of the first process that has not arrived yet
+	int runTime;
+	struct_heap_item *top;
+	struct_process_info *process;
+	struct_process_info *running = NULL; //the process that ran last and has not completed, only used for the trace
+	int lastRan = -1; //id of the process that ran last, completed or not
+	Heap *heap;
+
+	if (arraySize <= 0)
+		return;
+	heap = ConstructHeap(arraySize);
+	timeCounter = processes[0].arriveTime;
+
+	while (flag < arraySize)
+	{
+		flag += admitArrivalsToHeap(heap, processes, arraySize, &nextArrival, timeCounter + 1, remainingTimeKey, config);
+		if (heap->size == 0) //the CPU is idle - jump straight to the next arrival
+		{
+			if (nextArrival >= arraySize)
+				break;
+			timeCounter = processes[nextArrival].arriveTime;
+			continue;
+		}
+		top = HeapTop(heap);
+		process = &processes[top->index];
+		if (process != running) //an arrival has preempted the running process, or the CPU was free
+		{
+			if (running != NULL)
+				preemptProcess(config, timeCounter, running);
+			timeCounter += dispatchOverhead(config, process, &lastRan);
+			traceEvent(config, TRACE_DISPATCH, timeCounter, process);
+			running = process;
+		}
+		runTime = process->remainingTime;
+		if (nextArrival < arraySize && processes[nextArrival].arriveTime - timeCounter < runTime) //run until the next arrival
+			runTime = processes[nextArrival].arriveTime - timeCounter;
+		if (runTime < 0) //the next process arrived during the switch, it is compared before this one runs
+			runTime = 0;
+		timeCounter += runTime;
+		process->remainingTime -= runTime;
+
+		if (process->remainingTime == 0)
+		{
+			HeapPop(heap);
+			completeProcess(process, timeCounter, config->stats);
+			traceEvent(config, TRACE_COMPLETE, timeCounter, process);
+			running = NULL;
+			flag++;
+		}
+		else
+			top->key = process->remainingTime; //the smallest key got smaller, so the heap is still in order
+	}
+	DestructHeap(heap);
+}
+
+/*
+ * @brief - multilevelFeedbackQueue - round robin over MLFQ_LEVELS queues, moving processes down as they use up quanta
+ *
+ * Arriving processes join the top queue. A process always comes from the highest queue that is not empty and runs for
+ * the time quantum of its queue, which doubles on every level down. A process that uses its whole quantum moves one
+ * queue down (the bottom queue keeps it), and one that is in a lower queue is preempted as soon as a new process
+ * arrives and placed at the back of its queue.
+ */
+void multilevelFeedbackQueue(struct_process_info *processes, int arraySize, const struct_sim_config *config)
+{
+	int timeCounter;
+	int flag = 0; //number of completed processes
+	int nextArrival = 0; //index of the first process that has not arrived yet
+	int level, nextLevel, runTime, quantum;
+	int lastRan = -1;
+	Queue *levels[MLFQ_LEVELS];
+	NODE *processNode;
+
+	if (arraySize <= 0)
+		return;
+	for (level = 0; level < MLFQ_LEVELS; level++)
+		levels[level] = ConstructQueueOfType(arraySize, QUEUE_RING, processes);
+	timeCounter = processes[0].arriveTime;
+
+	while (flag < arraySize)
+	{
+		flag += admitArrivals(levels[0], processes, arraySize, &nextArrival, timeCounter + 1, config->stats); //arrivals join the top queue
+		for (level = 0; level < MLFQ_LEVELS && isEmpty(levels[level]); level++)
+			;
+		if (level == MLFQ_LEVELS) //the CPU is idle - jump straight to the next arrival
+		{
+			if (nextArrival >= arraySize)
+				break;
+			timeCounter = processes[nextArrival].arriveTime;
+			continue;
+		}
+
+		processNode = front(levels[level]);
+		timeCounter += dispatchOverhead(config, processNode->data, &lastRan);
+		quantum = config->timeQuantum << level; //the quantum doubles on every level down
+		runTime = processNode->data->remainingTime;
+		nextLevel = level;
+		if (config->timeQuantum > 0 && runTime > quantum)
+		{
+			runTime = quantum;
+			nextLevel = level + 1 < MLFQ_LEVELS ? level + 1 : level; //it used the whole quantum so it moves down
+		}
+		if (level > 0 && nextArrival < arraySize && processes[nextArrival].arriveTime - timeCounter < runTime)
+		{
+			runTime = processes[nextArrival].arriveTime - timeCounter; //preempted by a process arriving in the top queue
+			if (runTime < 0) //it arrived during the switch
+				runTime = 0;
+			nextLevel = level;
+		}
+		traceEvent(config, TRACE_DISPATCH, timeCounter, processNode->data);
+		timeCounter += runTime;
+		processNode->data->remainingTime -= runTime;
+		flag += admitArrivals(levels[0], processes, arraySize, &nextArrival, timeCounter, config->stats); //processes that arrived while it was running
+
+		processNode = Dequeue(levels[level]);
+		if (processNode->data->remainingTime == 0)
+		{
+			completeProcess(processNode->data, timeCounter, config->stats);
+			traceEvent(config, TRACE_COMPLETE, timeCounter, processNode->data);
+			flag++;
+			ReleaseNode(levels[level], processNode);
+		}
+		else
+		{
+			preemptProcess(config, timeCounter, processNode->data);
+			Enqueue(levels[nextLevel], processNode); //stores the index, the node itself goes back to the pool
+			if (nextLevel != level) //the node belongs to the pool of the queue it was taken from
+				ReleaseNode(levels[level], processNode);
+		}
+	}
+	for (level = 0; level < MLFQ_LEVELS; level++)
+		DestructQueue(levels[level]);
+}
+/* ************************ End of Methods and functions for the other scheduling policies **************************** */
+
+
+
+
+
+/* ************************ Methods and functions for the multi-core simulation **************************** */
+/*
+ * @brief - scheduleMultiCore - round robin on config->numOfCores CPUs
+ *
+ * Inputs: *processes - pointer to an array of processes sorted by arrive time - the results are written into each process
+ 			arraySize - size of the array
+ 			*config - the time quantum, the number of cores, how the cores share the processes and where the statistics go
+ *
+ * Like scheduleRoundRobin this jumps from one event to the next, but the ends of the running time slices are kept in a
+ * heap ordered by time and then by core, so each event costs O(log cores) however many cores there are. At every event
+ * the processes that arrived while the cores were running are queued first, then every slice that ends is completed or
+ * requeued in core order, then the processes arriving at that moment are queued and finally every idle core is given a
+ * process. With one core this is the same schedule as scheduleRoundRobin.
+ *
+ * With BALANCE_GLOBAL the idle cores take processes from one queue in arrival order. With BALANCE_STEAL arrivals are
+ * dealt to the cores' own queues in turn and a preempted process goes back to the queue of its core; a core whose queue
+ * is empty takes the oldest process from the next core that has one, found 64 cores at a time in a bitmap. The queues
+ * are linked through one array of next indices, so all of them together take O(processes + cores) memory.
+ */
+void scheduleMultiCore(struct_process_info *processes, int arraySize, const struct_sim_config *config)
+{
+	struct_multicore sim;
+	int timeCounter;
+	int flag = 0; //number of completed processes
+	int nextArrival = 0; //index of the first process that has not arrived yet
+	int core, index;
+	void *memory;
+	struct_heap_item item;
+
+	if (arraySize <= 0)
+		return;
+	sim.numOfCores = config->numOfCores > 0 ? config->numOfCores : 1;
+	if (posix_memalign(&memory, CACHE_LINE, sizeof (struct_core) * sim.numOfCores) != 0)
+	{
+		perror("posix_memalign");
+		exit(1);
+	}
+	sim.cores = (struct_core*) memory;
+	sim.globalQueue.head = -1;
+	sim.globalQueue.tail = -1;
+	sim.globalQueue.length = 0;
+	sim.next = (int*) malloc(sizeof (int) * arraySize);
+	sim.lastCore = (int*) malloc(sizeof (int) * arraySize);
+	sim.idleCores = (int*) malloc(sizeof (int) * sim.numOfCores);
+	sim.queuedCores = (uint64_t*) calloc((sim.numOfCores + 63) / 64, sizeof (uint64_t));
+	sim.events = ConstructHeap(sim.numOfCores);
+	if (sim.next == NULL || sim.lastCore == NULL || sim.idleCores == NULL || sim.queuedCores == NULL || sim.events == NULL)
+	{
+		perror("malloc");
+		exit(1);
+	}
+	sim.numOfIdle = 0;
+	sim.nextCore = 0;
+	sim.waiting = 0;
+	for (index = 0; index < arraySize; index++)
+		sim.lastCore[index] = -1; //not run yet
+	for (core = 0; core < sim.numOfCores; core++)
+	{
+		memset(&sim.cores[core], 0, sizeof (struct_core));
+		sim.cores[core].runQueue.head = -1;
+		sim.cores[core].runQueue.tail = -1;
+		sim.cores[core].running = -1;
+		sim.cores[core].lastRan = -1;
+		sim.idleCores[sim.numOfIdle++] = sim.numOfCores - 1 - core; //the idle cores are a stack, so core 0 is given work first
+	}
+	timeCounter = processes[0].arriveTime;
+
+	while (1)
+	{
+		flag += admitArrivalsToRunQueues(&sim, processes, arraySize, &nextArrival, timeCounter, config); //arrived while the cores were running
+
+		while (sim.events->size > 0 && HeapTop(sim.events)->key == timeCounter) //every time slice that ends now, in core order
+		{
+			item = HeapPop(sim.events);
+			core = item.index;
+			index = sim.cores[core].running;
+			sim.cores[core].running = -1;
+			sim.idleCores[sim.numOfIdle++] = core;
+			if (processes[index].remainingTime == 0)
+			{
+				completeProcess(&processes[index], timeCounter, config->stats);
+				traceEvent(config, TRACE_COMPLETE, timeCounter, &processes[index]);
+				flag++;
+			}
+			else //the time quantum expired, requeue the process
+			{
+				preemptProcess(config, timeCounter, &processes[index]);
+				queueOnCore(&sim, core, index, config);
+			}
+		}
+
+		flag += admitArrivalsToRunQueues(&sim, processes, arraySize, &nextArrival, timeCounter + 1, config); //arriving now
+		if (flag >= arraySize)
+			break;
+
+		while (sim.numOfIdle > 0 && sim.waiting > 0) //give the idle cores work, the core that went idle last first
+		{
+			core = sim.idleCores[--sim.numOfIdle];
+			dispatchOnCore(&sim, core, takeForCore(&sim, core, config), processes, timeCounter, config);
+		}
+
+		if (sim.events->size > 0) //jump to the next slice end or arrival
+			timeCounter = HeapTop(sim.events)->key;
+		if (nextArrival < arraySize && (sim.events->size == 0 || processes[nextArrival].arriveTime < timeCounter))
+			timeCounter = processes[nextArrival].arriveTime;
+		if (sim.events->size == 0 && nextArrival >= arraySize)
+			break;
+	}
+
+	if (config->coreStats != NULL)
+		for (core = 0; core < sim.numOfCores; core++)
+			config->coreStats[core] = sim.cores[core].stats;
+	DestructHeap(sim.events);
+	free(sim.queuedCores);
+	free(sim.idleCores);
+	free(sim.lastCore);
+	free(sim.next);
+	free(sim.cores);
+}
+
+/*
+ * @brief - admitArrivalsToRunQueues - queues every process that arrives before a given time for scheduleMultiCore
+ *
+ * With BALANCE_GLOBAL the processes join the global queue, with BALANCE_STEAL they are dealt to the cores in turn.
+ * Returns the number of processes that were completed on arrival because they have no burst time.
+ */
+int admitArrivalsToRunQueues(struct_multicore *sim, struct_process_info *processes, int arraySize, int *nextArrival,
+                             int beforeTime, const struct_sim_config *config)
+{
+	int completed = 0;
+
+	while (*nextArrival < arraySize && processes[*nextArrival].arriveTime < beforeTime)
+	{
+		if (processes[*nextArrival].remainingTime == 0) //a process with no burst time is completed as soon as it arrives
+		{
+			completeProcess(&processes[*nextArrival], processes[*nextArrival].arriveTime, config->stats);
+			completed++;
+		}
+		else
+		{
+			queueOnCore(sim, sim->nextCore, *nextArrival, config);
+			sim->nextCore = sim->nextCore + 1 < sim->numOfCores ? sim->nextCore + 1 : 0;
+		}
+		(*nextArrival)++;
+	}
+	return completed;
+}
+
+/*
+ * @brief - queueOnCore - adds a process to the run queue of a core, or to the global queue with BALANCE_GLOBAL
+ */
+void queueOnCore(struct_multicore *sim, int core, int index, const struct_sim_config *config)
+{
+	sim->waiting++;
+	if (config->balancing != BALANCE_STEAL)
+	{
+		runQueuePush(&sim->globalQueue, sim->next, index);
+		return;
+	}
+	runQueuePush(&sim->cores[core].runQueue, sim->next, index);
+	sim->queuedCores[core / 64] |= (uint64_t) 1 << (core % 64);
+}
+
+/*
+ * @brief - takeForCore - removes the process an idle core runs next - there must be a process waiting
+ *
+ * With BALANCE_STEAL the core takes from its own queue, or steals from the next core after it that has a queue.
+ */
+int takeForCore(struct_multicore *sim, int core, const struct_sim_config *config)
+{
+	int victim = core, index;
+
+	sim->waiting--;
+	if (config->balancing != BALANCE_STEAL)
+		return runQueuePop(&sim->globalQueue, sim->next);
+	if (sim->cores[core].runQueue.length == 0)
+	{
+		victim = findQueuedCore(sim, core + 1 < sim->numOfCores ? core + 1 : 0);
+		sim->cores[core].stats.steals++;
+	}
+	index = runQueuePop(&sim->cores[victim].runQueue, sim->next);
+	if (sim->cores[victim].runQueue.length == 0)
+		sim->queuedCores[victim / 64] &= ~((uint64_t) 1 << (victim % 64));
+	return index;
+}
+
+/*
+ * @brief - findQueuedCore - the first core at or after from, wrapping round, whose run queue is not empty
+ */
+int findQueuedCore(const struct_multicore *sim, int from)
+{
+	int numOfWords = (sim->numOfCores + 63) / 64;
+	int word = from / 64, step;
+	uint64_t bits = sim->queuedCores[word] & (~(uint64_t) 0 << (from % 64)); //ignore the cores before from
+
+	for (step = 0; step <= numOfWords; step++)
+	{
+		if (bits != 0)
+			return word * 64 + __builtin_ctzll(bits);
+		word = word + 1 < numOfWords ? word + 1 : 0;
+		bits = sim->queuedCores[word];
+	}
+	return -1;
+}
+
+/*
+ * @brief - dispatchOnCore - starts a process on an idle core for one time quantum, or until it completes
+ */
+void dispatchOnCore(struct_multicore *sim, int core, int index, struct_process_info *processes, int timeCounter,
+                    const struct_sim_config *config)
+{
+	struct_core *cpu = &sim->cores[core];
+	int sliceTime = processes[index].remainingTime;
+	int overhead = dispatchOverhead(config, &processes[index], &cpu->lastRan); //each core switches on its own
+
+	if (config->timeQuantum > 0 && sliceTime > config->timeQuantum)
+		sliceTime = config->timeQuantum;
+	traceEvent(config, TRACE_DISPATCH, timeCounter + overhead, &processes[index]);
+	processes[index].remainingTime -= sliceTime;
+	cpu->running = index;
+	cpu->stats.busyTime += sliceTime;
+	cpu->stats.dispatches++;
+	if (sim->lastCore[index] >= 0 && sim->lastCore[index] != core) //it last ran on another core
+		cpu->stats.migrations++;
+	sim->lastCore[index] = core;
+	HeapPush(sim->events, (long long) timeCounter + overhead + sliceTime, core);
+}
+
+void runQueuePush(struct_run_queue *queue, int *next, int index)
+{
+	next[index] = -1;
+	if (queue->length == 0)
+		queue->head = index;
+	else
+		next[queue->tail] = index;
+	queue->tail = index;
+	queue->length++;
+}
+
+int runQueuePop(struct_run_queue *queue, int *next)
+{
+	int index = queue->head;
+	queue->head = next[index];
+	queue->length--;
+	return index;
+}
+/* ************************ End of Methods and functions for the multi-core simulation **************************** */
+
+
+
+
+
+/* ************************ Methods and functions for running the schedule on threads **************************** */
+/*
+ * @brief - executeRoundRobin - runs a round robin schedule for real, with one thread per process doing CPU work
+ *
+ * Inputs: *processes - the processes, sorted by arrive time - they are not changed
+ 			arraySize - number of processes, at most EXECUTE_MAX_PROCESSES
+ 			timeQuantum - in time units, each EXECUTE_UNIT_NS long - 0 runs each process until it completes
+ 			*executor - filled in with the measured wait and turnaround times and the latencies - release it with DestructExecutor
+ *
+ * The calling thread is the dispatcher. It keeps the ready queue in the same order as scheduleRoundRobin, releases a
+ * process when the clock reaches its arrive time, and gives the CPU to one worker at a time by waking it on its own
+ * condition variable. The worker spins until it has run for the rest of its burst, and the dispatcher preempts it
+ * when the time quantum runs out. The workers are pinned to one CPU, so only one process runs at a time as in the
+ * simulation, and the dispatcher to another CPU when there is one. When permitted the dispatcher and the workers run
+ * with SCHED_FIFO, the dispatcher above the workers, so that it preempts a worker as soon as the quantum ends.
+ * Returns 0 on success or -1 if the threads could not be created.
+ */
+int executeRoundRobin(struct_process_info *processes, int arraySize, int timeQuantum, struct_executor *executor)
+{
+	struct_worker *worker;
+	pthread_attr_t attributes;
+	pthread_condattr_t conditionAttributes;
+	struct sched_param param, oldParam;
+	struct timespec deadline;
+	cpu_set_t oldAffinity; //the CPUs thread 1 may use, given back to it at the end
+	int oldPolicy, index, cpu, first = 0, size = 0, nextArrival = 0, completed = 0;
+	int *ring; //indices of the waiting processes, in queue order from first
+
+	memset(executor, 0, sizeof (struct_executor));
+	executor->count = arraySize;
+	executor->workerCpu = executor->dispatcherCpu = -1;
+	executor->workers = (struct_worker*) calloc(arraySize > 0 ? arraySize : 1, sizeof (struct_worker));
+	executor->waitTime = (double*) calloc(arraySize > 0 ? arraySize : 1, sizeof (double));
+	executor->turnAroundTime = (double*) calloc(arraySize > 0 ? arraySize : 1, sizeof (double));
+	ring = (int*) malloc(sizeof (int) * (arraySize > 0 ? arraySize : 1));
+	if (executor->workers == NULL || executor->waitTime == NULL || executor->turnAroundTime == NULL || ring == NULL)
+	{
+		perror("malloc");
+		free(ring);
+		return -1;
+	}
+
+	/* the workers share the last CPU this process may use and the dispatcher takes the first other one */
+	pthread_getaffinity_np(pthread_self(), sizeof oldAffinity, &oldAffinity);
+	for (cpu = CPU_SETSIZE - 1; cpu >= 0 && executor->workerCpu < 0; cpu--)
+		if (CPU_ISSET(cpu, &oldAffinity))
+			executor->workerCpu = cpu;
+	for (cpu = 0; cpu < CPU_SETSIZE && executor->dispatcherCpu < 0; cpu++)
+		if (CPU_ISSET(cpu, &oldAffinity) && (cpu != executor->workerCpu || CPU_COUNT(&oldAffinity) == 1))
+			executor->dispatcherCpu = cpu;
+	if (pinThread(pthread_self(), executor->dispatcherCpu) != 0)
+		executor->dispatcherCpu = -1;
+	pthread_getschedparam(pthread_self(), &oldPolicy, &oldParam);
+	param.sched_priority = sched_get_priority_min(SCHED_FIFO) + 1;
+	executor->realTime = pthread_setschedparam(pthread_self(), SCHED_FIFO, &param) == 0;
+
+	pthread_attr_init(&attributes);
+	pthread_attr_setstacksize(&attributes, EXECUTE_STACK_BYTES);
+	if (executor->realTime) //the workers run one level below the dispatcher
+	{
+		pthread_attr_setinheritsched(&attributes, PTHREAD_EXPLICIT_SCHED);
+		pthread_attr_setschedpolicy(&attributes, SCHED_FIFO);
+		param.sched_priority--;
+		pthread_attr_setschedparam(&attributes, &param);
+	}
+	pthread_condattr_init(&conditionAttributes);
+	pthread_condattr_setclock(&conditionAttributes, CLOCK_MONOTONIC); //the deadlines are on the monotonic clock
+	for (index = 0; index < arraySize; index++)
+	{
+		worker = &executor->workers[index];
+		worker->executor = executor;
+		worker->remaining = processes[index].burstTime * EXECUTE_UNIT_NS;
+		pthread_mutex_init(&worker->lock, NULL);
+		pthread_cond_init(&worker->wake, &conditionAttributes);
+		pthread_cond_init(&worker->changed, &conditionAttributes);
+		if (pthread_create(&worker->thread, &attributes, (void *)workerRoutine, worker) != 0)
+		{
+			perror("pthread_create");
+			executor->count = index; //only these are joined by DestructExecutor
+			free(ring);
+			pthread_attr_destroy(&attributes);
+			pthread_condattr_destroy(&conditionAttributes);
+			pthread_setschedparam(pthread_self(), oldPolicy, &oldParam);
+			pthread_setaffinity_np(pthread_self(), sizeof oldAffinity, &oldAffinity);
+			return -1;
+		}
+		if (executor->workerCpu >= 0 && pinThread(worker->thread, executor->workerCpu) != 0)
+			executor->workerCpu = -1;
+	}
+	pthread_attr_destroy(&attributes);
+	pthread_condattr_destroy(&conditionAttributes);
+
+	clock_gettime(CLOCK_MONOTONIC, &executor->start); //arrive time 0
+	while (completed < arraySize)
+	{
+		completed += admitExecutorArrivals(processes, arraySize, &nextArrival, ring, first, &size, executorTime(executor));
+		if (size == 0) //the CPU is idle until the next arrival
+		{
+			if (nextArrival < arraySize)
+			{
+				executorDeadline(executor, processes[nextArrival].arriveTime * EXECUTE_UNIT_NS, &deadline);
+				while (clock_nanosleep(CLOCK_MONOTONIC, TIMER_ABSTIME, &deadline, NULL) == EINTR)
+					;
+			}
+			continue;
+		}
+
+		index = ring[first];
+		first = first + 1 < arraySize ? first + 1 : 0;
+		size--;
+		worker = &executor->workers[index];
+		dispatchWorker(executor, worker, timeQuantum);
+		completed += admitExecutorArrivals(processes, arraySize, &nextArrival, ring, first, &size, worker->parkedAt); //arrived while it ran
+		if (worker->remaining > 0) //the time quantum expired, requeue the process behind the arrivals
+			ring[(first + size++) % arraySize] = index;
+		else
+		{
+			executor->turnAroundTime[index] = (double) worker->parkedAt / EXECUTE_UNIT_NS - processes[index].arriveTime;
+			executor->waitTime[index] = executor->turnAroundTime[index] - processes[index].burstTime;
+			completed++;
+		}
+	}
+
+	pthread_setschedparam(pthread_self(), oldPolicy, &oldParam); //thread 1 goes back to how it was running before
+	pthread_setaffinity_np(pthread_self(), sizeof oldAffinity, &oldAffinity);
+	free(ring);
+	return 0;
+}
+
+/*
+ * @brief - executeAndReport - runs the simulated schedule of thread 1 on threads and sends the comparison as text frames
+ *
+ * Inputs: *processes - the processes after the simulation, sorted by arrive time, with the simulated results
+ */
+void executeAndReport(struct_frame_writer *frames, struct_process_info *processes, int arraySize, int timeQuantum)
+{
+	struct_executor *executor;
+	char text[FRAME_BATCH_BYTES - sizeof (struct_frame_header)];
+	size_t used = 0;
+	int index;
+
+	if (arraySize > EXECUTE_MAX_PROCESSES)
+	{
+		used = snprintf(text, sizeof text, "Not executed on threads - -e runs at most %d processes \n", EXECUTE_MAX_PROCESSES);
+		writeFrame(frames, FRAME_TEXT, text, used);
+		return;
+	}
+	if ((executor = (struct_executor*) malloc(sizeof (struct_executor))) == NULL)
+	{
+		perror("malloc");
+		return;
+	}
+	printf("Running %d processes on threads, 1 time unit = %lld us\n", arraySize, EXECUTE_UNIT_NS / 1000);
+	if (executeRoundRobin(processes, arraySize, timeQuantum, executor) == 0)
+	{
+		used = formatExecution(text, sizeof text, executor, processes, arraySize);
+		for (index = 0; index < arraySize; index++) //one line per process, as many as fit in each frame
+		{
+			if (used + MSGLENGTH > sizeof text)
+			{
+				writeFrame(frames, FRAME_TEXT, text, used);
+				used = 0;
+			}
+			used += formatExecutedProcess(text + used, sizeof text - used, &processes[index], executor, index);
+		}
+		writeFrame(frames, FRAME_TEXT, text, used);
+	}
+	DestructExecutor(executor);
+	free(executor);
+}
+
+/*
+ * @brief - admitExecutorArrivals - adds the processes that have arrived by a time, in nanoseconds, to the ready queue
+ *
+ * Inputs: *ring, first, *size - the ready queue of executeRoundRobin, with room for every process
+ *
+ * Returns the number of processes that were completed on arrival because they have no burst time.
+ */
+int admitExecutorArrivals(const struct_process_info *processes, int arraySize, int *nextArrival, int *ring, int first,
+                          int *size, long long time)
+{
+	int completed = 0;
+
+	for (; *nextArrival < arraySize && processes[*nextArrival].arriveTime * EXECUTE_UNIT_NS <= time; (*nextArrival)++)
+	{
+		if (processes[*nextArrival].burstTime == 0)
+			completed++;
+		else
+			ring[(first + (*size)++) % arraySize] = *nextArrival;
+	}
+	return completed;
+}
+
+/*
+ * @brief - workerRoutine - the thread of one process - uses CPU time whenever the dispatcher lets it run
+ *
+ * The worker spins until it has used all of its remaining burst or the dispatcher sets preempt, then parks again.
+ * Like a kernel charging a timeslice, the time taken off its burst is the time from when it started running to when
+ * it stopped, so it is also charged for interrupts and for the time the preemption took to reach it.
+ */
+void *workerRoutine(struct_worker *worker)
+{
+	volatile unsigned long work = 0; //the CPU work the process does
+	long long used = 0;
+
+	pthread_mutex_lock(&worker->lock);
+	while (1)
+	{
+		while (worker->state == WORKER_PARKED)
+			pthread_cond_wait(&worker->wake, &worker->lock);
+		if (worker->state == WORKER_EXIT)
+			break;
+		worker->startedAt = executorTime(worker->executor); //the time quantum starts now
+		pthread_cond_signal(&worker->changed);
+		pthread_mutex_unlock(&worker->lock);
+
+		do
+		{
+			work++;
+			used = executorTime(worker->executor) - worker->startedAt;
+		} while (used < worker->remaining && !atomic_load_explicit(&worker->preempt, memory_order_relaxed));
+
+		pthread_mutex_lock(&worker->lock);
+		worker->parkedAt = executorTime(worker->executor);
+		used = worker->parkedAt - worker->startedAt; //up to the stop, as the preemption may come between reading the clock and preempt
+		worker->remaining = used < worker->remaining ? worker->remaining - used : 0;
+		worker->state = WORKER_PARKED;
+		pthread_cond_signal(&worker->changed);
+	}
+	pthread_mutex_unlock(&worker->lock);
+	return NULL;
+}
+
+/*
+ * @brief - dispatchWorker - gives the CPU to a worker and waits until it completes or its time quantum runs out
+ *
+ * The time quantum starts when the worker signals that it is running. The dispatch latency, from waking the worker
+ * to it running, and the preemption latency, from the end of the quantum to the worker stopping, are added to the
+ * executor.
+ */
+void dispatchWorker(struct_executor *executor, struct_worker *worker, int timeQuantum)
+{
+	struct timespec deadline;
+	long long latency, quantumEnd = -1;
+
+	pthread_mutex_lock(&worker->lock);
+	atomic_store(&worker->preempt, 0);
+	worker->startedAt = -1;
+	worker->dispatchedAt = executorTime(executor);
+	worker->state = WORKER_RUNNING;
+	pthread_cond_signal(&worker->wake);
+	if (timeQuantum > 0)
+	{
+		while (worker->startedAt < 0) //the quantum is timed from when the worker is actually running, like a kernel timeslice
+			pthread_cond_wait(&worker->changed, &worker->lock);
+		quantumEnd = worker->startedAt + timeQuantum * EXECUTE_UNIT_NS;
+		executorDeadline(executor, quantumEnd, &deadline);
+		while (worker->state == WORKER_RUNNING && pthread_cond_timedwait(&worker->changed, &worker->lock, &deadline) != ETIMEDOUT)
+			;
+		if (worker->state == WORKER_RUNNING) //the time quantum expired
+			atomic_store(&worker->preempt, 1);
 		else
-			timeCounter++; //increment time
+			quantumEnd = -1;
+	}
+	while (worker->state == WORKER_RUNNING)
+		pthread_cond_wait(&worker->changed, &worker->lock);
+	pthread_mutex_unlock(&worker->lock);
+
+	executor->dispatches++;
+	latency = worker->startedAt - worker->dispatchedAt;
+	executor->totalDispatchLatency += latency;
+	if (latency > executor->maxDispatchLatency)
+		executor->maxDispatchLatency = latency;
+	executor->dispatchLatency[histogramBucket(latency / 1000)]++;
+	if (quantumEnd >= 0)
+	{
+		executor->preemptions++;
+		latency = worker->parkedAt > quantumEnd ? worker->parkedAt - quantumEnd : 0;
+		executor->totalPreemptLatency += latency;
+		if (latency > executor->maxPreemptLatency)
+			executor->maxPreemptLatency = latency;
+		executor->preemptLatency[histogramBucket(latency / 1000)]++;
 	}
-	DestructQueue(processQueue); //free the memory used by the Queue struct
 }
 
 /*
- * @brief - averageWaitTime - adds all the wait times from the processes and calculates the average wait time
+ * @brief - executorTime - nanoseconds since arrive time 0 of an executor
+ */
+long long executorTime(const struct_executor *executor)
+{
+	return nanosecondsSince(&executor->start);
+}
+
+/*
+ * @brief - executorDeadline - the CLOCK_MONOTONIC time that is a number of nanoseconds after arrive time 0
+ */
+void executorDeadline(const struct_executor *executor, long long time, struct timespec *deadline)
+{
+	time += executor->start.tv_nsec;
+	deadline->tv_sec = executor->start.tv_sec + time / 1000000000LL;
+	deadline->tv_nsec = time % 1000000000LL;
+}
+
+/*
+ * @brief - pinThread - lets a thread run only on one CPU - returns 0 on success, or an error number if not permitted
+ */
+int pinThread(pthread_t thread, int cpu)
+{
+	cpu_set_t cpus;
+
+	if (cpu < 0)
+		return EINVAL;
+	CPU_ZERO(&cpus);
+	CPU_SET(cpu, &cpus);
+	return pthread_setaffinity_np(thread, sizeof cpus, &cpus);
+}
+
+/*
+ * @brief - DestructExecutor - stops the worker threads and frees what executeRoundRobin allocated
+ */
+void DestructExecutor(struct_executor *executor)
+{
+	struct_worker *worker;
+	int index;
+
+	for (index = 0; executor->workers != NULL && index < executor->count; index++)
+	{
+		worker = &executor->workers[index];
+		pthread_mutex_lock(&worker->lock);
+		worker->state = WORKER_EXIT;
+		pthread_cond_signal(&worker->wake);
+		pthread_mutex_unlock(&worker->lock);
+		pthread_join(worker->thread, NULL);
+		pthread_mutex_destroy(&worker->lock);
+		pthread_cond_destroy(&worker->wake);
+		pthread_cond_destroy(&worker->changed);
+	}
+	free(executor->workers);
+	free(executor->waitTime);
+	free(executor->turnAroundTime);
+}
+
+/*
+ * @brief - formatExecutedProcess - writes the simulated and measured wait and turnaround times of one process
  *
- * Inputs: *processes - pointer to an array of processes - in which the function accesses the wait times of each process in the array
- 			arraySize - size of the array - as the array size cannot be passed down from a pointer
+ * Returns the number of characters written, like snprintf.
+ */
+int formatExecutedProcess(char *buffer, size_t length, const struct_process_info *process, const struct_executor *executor,
+                          int index)
+{
+	return snprintf(buffer, length, "Process[%d] Wait Time: simulated %d, measured %.3f, Turnaround Time: simulated %d, measured %.3f \n",
+	                process->processId, process->waitTime, executor->waitTime[index], process->turnAroundTime,
+	                executor->turnAroundTime[index]);
+}
+
+/*
+ * @brief - formatExecution - writes the averages of the simulated and the measured schedule, and the dispatch jitter
  *
+ * The latencies are in microseconds, with the 99th percentile read from their histograms.
+ * Returns the number of characters written, like snprintf.
  */
-double averageWaitTime(struct_process_info *processes, int arraySize)
+int formatExecution(char *buffer, size_t length, const struct_executor *executor, const struct_process_info *processes,
+                    int arraySize)
 {
-	int totalWaitTime = 0, elementIndex;
-	for (elementIndex = 0; elementIndex < arraySize; elementIndex++)
-		totalWaitTime += processes[elementIndex].waitTime;
-	return (double)totalWaitTime / arraySize;
+	double simulatedWait = 0, simulatedTurnAround = 0, measuredWait = 0, measuredTurnAround = 0;
+	long long dispatches = executor->dispatches > 0 ? executor->dispatches : 1;
+	long long preemptions = executor->preemptions > 0 ? executor->preemptions : 1;
+	int index;
+
+	for (index = 0; index < arraySize; index++)
+	{
+		simulatedWait += processes[index].waitTime;
+		simulatedTurnAround += processes[index].turnAroundTime;
+		measuredWait += executor->waitTime[index];
+		measuredTurnAround += executor->turnAroundTime[index];
+	}
+	if (arraySize > 0)
+	{
+		simulatedWait /= arraySize;
+		simulatedTurnAround /= arraySize;
+		measuredWait /= arraySize;
+		measuredTurnAround /= arraySize;
+	}
+	return snprintf(buffer, length,
+	                "Executed on threads, 1 time unit = %lld us, SCHED_FIFO: %s, workers on CPU %d, dispatcher on CPU %d \n"
+	                "Average Wait Time: simulated %lf, measured %lf \n"
+	                "Average Turnaround Time: simulated %lf, measured %lf \n"
+	                "Dispatch Latency (us): %lld dispatches, mean %.1lf, p99 %d, max %.1lf \n"
+	                "Preemption Latency (us): %lld preemptions, mean %.1lf, p99 %d, max %.1lf \n",
+	                EXECUTE_UNIT_NS / 1000, executor->realTime ? "yes" : "not permitted", executor->workerCpu,
+	                executor->dispatcherCpu, simulatedWait, measuredWait, simulatedTurnAround, measuredTurnAround,
+	                executor->dispatches, executor->totalDispatchLatency / 1e3 / dispatches,
+	                statsQuantile(executor->dispatchLatency, executor->dispatches, 0.99), executor->maxDispatchLatency / 1e3,
+	                executor->preemptions, executor->totalPreemptLatency / 1e3 / preemptions,
+	                statsQuantile(executor->preemptLatency, executor->preemptions, 0.99), executor->maxPreemptLatency / 1e3);
 }
+/* ************************ End of Methods and functions for running the schedule on threads **************************** */
+
+
 
+
+
+/* ************************ Methods and functions for sweeping time quanta **************************** */
 /*
- * @brief - averageTurnAroundTime - adds all the turnaround times from the processes and calculates the average turnaround time
+ * @brief - sweepMain - runs every policy in a list with every time quantum in a range or list and writes a table
  *
- * Inputs: *processes - pointer to an array of processes - in which the function accesses the turnaround times of each process in the array
- 			arraySize - size of the array - as the array size cannot be passed down from a pointer
+ * Inputs: *quanta - first:last[:step] or a comma separated list of time quanta
+ 			*outputFile - file the table is written to
+ 			*policyNames - comma separated list of policies
+ 			*options - the other command line options
  *
+ * The processes are read and sorted once. Each (policy, time quantum) pair is an independent simulation, so they are
+ * run by a fixed pool of worker threads, one per CPU core, that each keep a private copy of the processes.
+ * Policies that do not use a time quantum are only run once.
  */
-double averageTurnAroundTime(struct_process_info *processes, int arraySize)
+int sweepMain(char *quanta, char *outputFile, char *policyNames, struct_options *options)
 {
-	int totalTurnAroundTime = 0, elementIndex;
-	for (elementIndex = 0; elementIndex < arraySize; elementIndex++)
-		totalTurnAroundTime += processes[elementIndex].turnAroundTime;
-	return (double)totalTurnAroundTime / arraySize;
+	const struct_policy *sweepPolicies[16];
+	struct_sweep_info sweep;
+	struct_process_info *processes;
+	pthread_t *workers;
+	FILE *fp;
+	char *name, *table, *line;
+	int *quantumList, numOfQuanta, numOfPolicies = 0, numOfProcesses, numOfWorkers, askPriority = 0;
+	int policy, quantum, index, parsed, result = 0;
+
+	if ((parsed = parseQuanta(quanta, &quantumList, &numOfQuanta)) != 0)
+	{
+		if (parsed == -1)
+			printf("The time quanta must be first:last[:step] or a comma separated list of positive integers \n");
+		return -1;
+	}
+	for (name = strtok(policyNames, ","); name != NULL; name = strtok(NULL, ",")) //find each policy in the list
+	{
+		if (numOfPolicies == 16 || (sweepPolicies[numOfPolicies] = findPolicy(name)) == NULL)
+		{
+			printf(numOfPolicies == 16 ? "Too many policies: %s\n" : "Unknown policy: %s\n", name);
+			usage();
+			free(quantumList);
+			return -1;
+		}
+		askPriority |= sweepPolicies[numOfPolicies++]->usesPriority;
+	}
+
+	if (options->inputFile != NULL)
+	{
+		if (loadWorkload(options->inputFile, &processes, &numOfProcesses) != 0)
+		{
+			free(quantumList);
+			return -1;
+		}
+		printf("Read %d processes from %s\n\n", numOfProcesses, options->inputFile);
+	}
+	else
+		processes = askForProcesses(&numOfProcesses, askPriority);
+	if (options->binaryFile != NULL)
+		if (saveWorkloadBinary(options->binaryFile, processes, numOfProcesses) != 0)
+			printf("The processes were not saved to %s\n", options->binaryFile);
+	if (sortByArrivalTimes(processes, numOfProcesses) != 0) //sorted once, every worker copies the sorted processes
+	{
+		perror("malloc");
+		exit(1);
+	}
+
+	sweep.processes = processes;
+	sweep.numOfProcesses = numOfProcesses;
+	sweep.agingInterval = options->agingInterval;
+	sweep.switchCost = options->switchCost;
+	sweep.dispatchLatency = options->dispatchLatency;
+	if ((long long) numOfPolicies * numOfQuanta > INT_MAX ||
+	        (sweep.jobs = (struct_sweep_job*) malloc(sizeof (struct_sweep_job) * numOfPolicies * numOfQuanta)) == NULL)
+	{
+		printf("Not enough memory for %d policies with %d time quanta\n", numOfPolicies, numOfQuanta);
+		free(processes);
+		free(quantumList);
+		return -1;
+	}
+	sweep.numOfJobs = 0;
+	sweep.nextJob = 0;
+	pthread_mutex_init(&sweep.lock, NULL);
+	for (policy = 0; policy < numOfPolicies; policy++)
+		for (quantum = 0; quantum < (sweepPolicies[policy]->usesQuantum ? numOfQuanta : 1); quantum++)
+		{
+			sweep.jobs[sweep.numOfJobs].policy = sweepPolicies[policy];
+			sweep.jobs[sweep.numOfJobs].timeQuantum = sweepPolicies[policy]->usesQuantum ? quantumList[quantum] : 0;
+			sweep.numOfJobs++;
+		}
+
+	numOfWorkers = sysconf(_SC_NPROCESSORS_ONLN); //one worker per core, but no more than there are simulations
+	if (numOfWorkers < 1)
+		numOfWorkers = 1;
+	if (numOfWorkers > sweep.numOfJobs)
+		numOfWorkers = sweep.numOfJobs;
+	printf("Running %d simulations on %d threads\n", sweep.numOfJobs, numOfWorkers);
+	if ((workers = (pthread_t*) malloc(sizeof (pthread_t) * numOfWorkers)) == NULL)
+	{
+		perror("malloc");
+		exit(1);
+	}
+	for (index = 0; index < numOfWorkers; index++)
+		if (pthread_create(&workers[index], NULL, (void *)sweepWorker_routine, &sweep) != 0)
+		{
+			perror("pthread_create");
+			exit(1);
+		}
+	for (index = 0; index < numOfWorkers; index++)
+		pthread_join(workers[index], NULL);
+
+	if ((table = (char*) malloc((size_t) SWEEP_LINE_LENGTH * (sweep.numOfJobs + 1))) == NULL)
+	{
+		perror("malloc");
+		exit(1);
+	}
+	line = table;
+	line += sprintf(line, "%-10s %8s %20s %24s %12s %12s %12s %14s\n", "Policy", "Quantum", "Average Wait Time",
+	                "Average Turnaround Time", "Switches", "Overhead", "Throughput", "Effective CPU");
+	for (index = 0; index < sweep.numOfJobs; index++)
+	{
+		char quantum[16] = "-";
+		if (sweep.jobs[index].policy->usesQuantum)
+			sprintf(quantum, "%d", sweep.jobs[index].timeQuantum);
+		line += sprintf(line, "%-10s %8s %20lf %24lf %12lld %12lld %12lf %13.2lf%%\n", sweep.jobs[index].policy->name, quantum,
+		                sweep.jobs[index].avgWaitTime, sweep.jobs[index].avgTurnAroundTime, sweep.jobs[index].contextSwitches,
+		                sweep.jobs[index].overheadTime, sweep.jobs[index].throughput, sweep.jobs[index].effectiveUtilisation);
+	}
+
+	if ((fp = fopen(outputFile, "w")) == NULL)
+	{
+		perror("Error opening file");
+		result = -1;
+	}
+	else
+	{
+		writeToFile(fp, table);
+		fclose(fp);
+	}
+
+	pthread_mutex_destroy(&sweep.lock);
+	free(table);
+	free(workers);
+	free(sweep.jobs);
+	free(processes);
+	free(quantumList);
+	return result;
 }
 
-/* ************************ End of Methods and functions for using Round robin **************************** */
+/*
+ * @brief - sweepWorker_routine - takes simulations off the shared list until there are none left
+ *
+ * The worker copies the sorted processes into its own array before each simulation, so the workers never write to
+ * the same memory apart from the result of their own job. The switch counts and overhead come from private statistics.
+ */
+void *sweepWorker_routine(struct_sweep_info *sweep)
+{
+	struct_process_info *processes;
+	struct_sim_stats *stats;
+	struct_sweep_job *job;
+	struct_sim_config config;
+	long long elapsed;
+	int jobIndex;
+
+	processes = (struct_process_info*) malloc(sizeof (struct_process_info) * (sweep->numOfProcesses > 0 ? sweep->numOfProcesses : 1));
+	stats = (struct_sim_stats*) malloc(sizeof (struct_sim_stats));
+	if (processes == NULL || stats == NULL)
+	{
+		perror("malloc");
+		exit(1);
+	}
+	while (1)
+	{
+		pthread_mutex_lock(&sweep->lock); //take the next simulation that has not been started
+		jobIndex = sweep->nextJob++;
+		pthread_mutex_unlock(&sweep->lock);
+		if (jobIndex >= sweep->numOfJobs)
+			break;
+
+		job = &sweep->jobs[jobIndex];
+		memcpy(processes, sweep->processes, sizeof (struct_process_info) * sweep->numOfProcesses);
+		memset(&config, 0, sizeof config);
+		config.timeQuantum = job->timeQuantum;
+		config.agingInterval = sweep->agingInterval;
+		config.switchCost = sweep->switchCost;
+		config.dispatchLatency = sweep->dispatchLatency;
+		config.stats = stats;
+		initialiseStats(stats);
+		job->policy->run(processes, sweep->numOfProcesses, &config);
+		job->avgWaitTime = averageWaitTime(processes, sweep->numOfProcesses);
+		job->avgTurnAroundTime = averageTurnAroundTime(processes, sweep->numOfProcesses);
+		elapsed = stats->count > 0 ? (long long) stats->lastCompletion - stats->firstArrival : 0;
+		job->contextSwitches = stats->contextSwitches;
+		job->overheadTime = stats->overheadTime;
+		job->throughput = elapsed > 0 ? stats->count / (double) elapsed : 0;
+		job->effectiveUtilisation = elapsed > 0 ? 100.0 * stats->busyTime / elapsed : 0;
+	}
+	free(stats);
+	free(processes);
+	return NULL;
+}
+
+/*
+ * @brief - parseQuanta - reads first:last[:step] or a comma separated list into a new array of time quanta
+ *
+ * Returns 0 on success, -1 if the text is not a valid range or list of positive integers, or -2 after printing why if
+ * there is not enough memory for the list.
+ */
+int parseQuanta(const char *text, int **quanta, int *count)
+{
+	long values[3] = {0, 0, 1};
+	char *end;
+	int numOfValues = 0, index;
+	const char *position = text;
+
+	*quanta = NULL;
+	*count = 0;
+	if (strchr(text, ':') != NULL) //first:last[:step]
+	{
+		while (numOfValues < 3)
+		{
+			if (!isdigit((unsigned char) *position))
+				return -1;
+			values[numOfValues++] = strtol(position, &end, 10);
+			position = end;
+			if (*position != ':')
+				break;
+			position++;
+		}
+		if (*position != 0 || numOfValues < 2 || values[0] < 1 || values[1] < values[0] || values[2] < 1 || values[1] > INT_MAX)
+			return -1;
+		*count = (values[1] - values[0]) / values[2] + 1;
+		if ((*quanta = (int*) malloc(sizeof (int) * *count)) == NULL)
+		{
+			perror("malloc");
+			return -2;
+		}
+		for (index = 0; index < *count; index++)
+			(*quanta)[index] = values[0] + index * values[2];
+		return 0;
+	}
+
+	for (index = 0; text[index] != 0; index++) //one more quantum than there are commas
+		if (text[index] == ',')
+			(*count)++;
+	(*count)++;
+	if ((*quanta = (int*) malloc(sizeof (int) * *count)) == NULL)
+	{
+		perror("malloc");
+		return -2;
+	}
+	for (index = 0; index < *count; index++)
+	{
+		if (!isdigit((unsigned char) *position))
+			break;
+		values[0] = strtol(position, &end, 10);
+		if (values[0] < 1 || values[0] > INT_MAX || (*end != ',' && *end != 0))
+			break;
+		(*quanta)[index] = values[0];
+		position = end + 1;
+	}
+	if (index < *count)
+	{
+		free(*quanta);
+		*quanta = NULL;
+		return -1;
+	}
+	return 0;
+}
+/* ************************ End of Methods and functions for sweeping time quanta **************************** */
 
 
 
@@ -450,8 +4476,26 @@ void cleanInput(void)
 
 
 
-/* ************************* Methods and functions for Queue-Linked List implementation ***************************** */
+/* ************************* Methods and functions for Queue-Linked List and ring implementation ***************************** */
 Queue *ConstructQueue(int limit)
+{
+	return ConstructQueueOfType(limit, QUEUE_LINKED, NULL);
+}
+
+/*
+ * @brief - ConstructQueueOfType - creates a queue that links its nodes (QUEUE_LINKED) or keeps them in a ring (QUEUE_RING)
+ *
+ * Inputs: limit - the most items the queue can hold
+ 			type - QUEUE_LINKED or QUEUE_RING
+ 			*processes - QUEUE_RING only - every queued node must point into this array
+ *
+ * A QUEUE_RING queue keeps the index of each queued process in a circular array of limit ints, so requeueing a process
+ * only moves an int and the queue order is read from one block of memory. Its nodes are only handles: Enqueue stores
+ * the index and gives a pool node straight back to the pool, Dequeue fills a node from the pool and front fills a node
+ * inside the queue that is only valid until the queue is next changed. Both types are used through the same Enqueue,
+ * Dequeue, front and isEmpty functions.
+ */
+Queue *ConstructQueueOfType(int limit, int type, struct_process_info *processes)
 {
 	Queue *queue = (Queue*) malloc(sizeof (Queue));
 	if (queue == NULL)
@@ -459,6 +4503,23 @@ Queue *ConstructQueue(int limit)
 	if (limit <= 0) //limit cannot be less than 1, therefore set the limit to the maximum value.
 		limit = 65535;
 
+	queue->pool = (NODE*) malloc(sizeof (NODE) * limit); //one node for every item the queue can hold
+	queue->ring = NULL;
+	if (type == QUEUE_RING)
+		queue->ring = (int*) malloc(sizeof (int) * limit);
+	if (queue->pool == NULL || (type == QUEUE_RING && queue->ring == NULL))
+	{
+		free(queue->pool);
+		free(queue->ring);
+		free(queue);
+		return NULL;
+	}
+	queue->freeList = NULL;
+	queue->poolUsed = 0;
+	queue->type = type;
+	queue->processes = processes;
+	queue->first = 0;
+
 	queue->limit = limit;
 	queue->size = 0;
 	queue->head = NULL;
@@ -467,23 +4528,73 @@ Queue *ConstructQueue(int limit)
 	return queue;
 }
 
-
+/*
+ * @brief - DestructQueue - frees the queue and every node handed out by AllocateNode in one go
+ *
+ * Nodes that were allocated by the caller instead of AllocateNode are still owned by the caller.
+ */
 void DestructQueue(Queue *queue)
 {
-	NODE *pN;
-	while (!isEmpty(queue)) { //if not empty, delete all notes and free the memory used by them
-		pN = Dequeue(queue);
-		free(pN);
-	}
+	if (queue == NULL)
+		return;
+	free(queue->pool); //drop every node in the pool at once instead of freeing them one at a time
+	free(queue->ring);
 	free(queue); //free the memory used by the queue strucrt
 }
 
+/*
+ * @brief - AllocateNode - takes a node from the queue's pool instead of calling malloc
+ *
+ * Nodes given back by ReleaseNode are reused first. Returns NULL when all limit nodes are in use.
+ */
+NODE *AllocateNode(Queue *pQueue)
+{
+	NODE *item;
+	if (pQueue == NULL)
+		return NULL;
+	if (pQueue->freeList != NULL) //reuse a node that has been given back
+	{
+		item = pQueue->freeList;
+		pQueue->freeList = item->prev;
+	}
+	else if (pQueue->poolUsed < pQueue->limit) //otherwise hand out the next node that has never been used
+		item = &pQueue->pool[pQueue->poolUsed++];
+	else
+		return NULL;
+	item->data = NULL;
+	item->prev = NULL;
+	return item;
+}
+
+/*
+ * @brief - ReleaseNode - gives a node from AllocateNode back to the pool once it has been dequeued
+ */
+void ReleaseNode(Queue *pQueue, NODE *item)
+{
+	if (pQueue == NULL || item == NULL)
+		return;
+	item->prev = pQueue->freeList; //the free list is linked through the same pointer the queue uses
+	pQueue->freeList = item;
+}
+
 int Enqueue(Queue *pQueue, NODE *item)
 {
+	int position;
 	if ((pQueue == NULL) || (item == NULL)) //if bad parameters given
 		return 0;
 	if (pQueue->size >= pQueue->limit) //if size is greater than or equal to the limit, return as there is no more space
 		return 0;
+	if (pQueue->type == QUEUE_RING)
+	{
+		position = pQueue->first + pQueue->size; //the back of the queue, wrapped around to the start of the ring
+		if (position >= pQueue->limit)
+			position -= pQueue->limit;
+		pQueue->ring[position] = item->data - pQueue->processes; //only the index of the process is stored
+		pQueue->size++;
+		if (item >= pQueue->pool && item < pQueue->pool + pQueue->poolUsed) //the node itself is no longer needed
+			ReleaseNode(pQueue, item);
+		return 1;
+	}
 	/*the queue is empty*/
 	item->prev = NULL;
 	if (pQueue->size == 0) //if queue is empty, sent the node as the front and rear of the queue
@@ -507,6 +4618,17 @@ NODE * Dequeue(Queue *pQueue)
 	NODE *item;
 	if (isEmpty(pQueue))
 		return NULL; //if empty return NULL
+	if (pQueue->type == QUEUE_RING)
+	{
+		item = AllocateNode(pQueue); //hand the process at the front of the ring out in a node from the pool
+		if (item == NULL)
+			return NULL;
+		item->data = &pQueue->processes[pQueue->ring[pQueue->first]];
+		if (++pQueue->first == pQueue->limit) //wrap around to the start of the ring
+			pQueue->first = 0;
+		pQueue->size--;
+		return item;
+	}
 	item = pQueue->head;
 	pQueue->head = (pQueue->head)->prev; //remove front node and set the next node as the new front
 	pQueue->size--; //reduce the size by one
@@ -528,7 +4650,147 @@ NODE * front(Queue *pQueue)
 	NODE *item;
 	if (isEmpty(pQueue)) //if the queue is empty or queue is bad.
 		return NULL;
+	if (pQueue->type == QUEUE_RING)
+	{
+		pQueue->frontNode.data = &pQueue->processes[pQueue->ring[pQueue->first]];
+		pQueue->frontNode.prev = NULL;
+		return &pQueue->frontNode;
+	}
 	item = pQueue->head; //return the node from the front of the queue
 	return item;
 }
-/*************************** End of methods and functions for Queue-Linked List Implementation ****************/
+
+/*
+ * @brief - LiveQueuePush - copies a process to the back of a live queue, doubling the array if it is full
+ *
+ * Returns 0 on success or -1 if the memory could not be allocated.
+ */
+int LiveQueuePush(struct_live_queue *queue, const struct_process_info *process)
+{
+	struct_process_info *items;
+	size_t capacity, wrapped;
+
+	if (queue->size == queue->capacity)
+	{
+		capacity = queue->capacity > 0 ? queue->capacity * 2 : LIVE_QUEUE_START;
+		if ((items = (struct_process_info*) realloc(queue->items, sizeof (struct_process_info) * capacity)) == NULL)
+			return -1;
+		wrapped = queue->first + queue->size > queue->capacity ? queue->first + queue->size - queue->capacity : 0;
+		memcpy(items + queue->capacity, items, sizeof (struct_process_info) * wrapped); //unwrap the part at the start
+		queue->items = items;
+		queue->capacity = capacity;
+	}
+	queue->items[(queue->first + queue->size) % queue->capacity] = *process;
+	queue->size++;
+	return 0;
+}
+
+/*
+ * @brief - LiveQueuePop - copies the front process of a live queue that is not empty and removes it
+ */
+void LiveQueuePop(struct_live_queue *queue, struct_process_info *process)
+{
+	*process = queue->items[queue->first];
+	queue->first = queue->first + 1 < queue->capacity ? queue->first + 1 : 0;
+	queue->size--;
+}
+/*************************** End of methods and functions for Queue-Linked List and ring Implementation ****************/
+
+
+
+
+
+/* ************************* Methods and functions for the binary heap ***************************** */
+Heap *ConstructHeap(int limit)
+{
+	Heap *heap = (Heap*) malloc(sizeof (Heap));
+	if (heap == NULL)
+		return NULL;
+	if (limit <= 0)
+		limit = 65535;
+	heap->items = (struct_heap_item*) malloc(sizeof (struct_heap_item) * limit);
+	if (heap->items == NULL)
+	{
+		free(heap);
+		return NULL;
+	}
+	heap->size = 0;
+	heap->limit = limit;
+	return heap;
+}
+
+void DestructHeap(Heap *heap)
+{
+	if (heap == NULL)
+		return;
+	free(heap->items);
+	free(heap);
+}
+
+/*
+ * @brief - heapItemLess - 1 if item a comes before item b - by key, then by index so that earlier arrivals go first
+ */
+int heapItemLess(const struct_heap_item *a, const struct_heap_item *b)
+{
+	return a->key < b->key || (a->key == b->key && a->index < b->index);
+}
+
+int HeapPush(Heap *heap, long long key, int index)
+{
+	int position, parent;
+	struct_heap_item item = {key, index};
+
+	if (heap == NULL || heap->size >= heap->limit) //no more space
+		return 0;
+	position = heap->size++;
+	while (position > 0) //move the item up until its parent comes before it
+	{
+		parent = (position - 1) / 2;
+		if (!heapItemLess(&item, &heap->items[parent]))
+			break;
+		heap->items[position] = heap->items[parent];
+		position = parent;
+	}
+	heap->items[position] = item;
+	return 1;
+}
+
+/*
+ * @brief - HeapPop - removes and returns the item with the smallest key - the heap must not be empty
+ */
+struct_heap_item HeapPop(Heap *heap)
+{
+	struct_heap_item top = heap->items[0];
+	heap->items[0] = heap->items[--heap->size]; //move the last item to the top and let it sink
+	if (heap->size > 0)
+		HeapSiftDown(heap, 0);
+	return top;
+}
+
+/*
+ * @brief - HeapSiftDown - moves the item at position down until both of its children come after it
+ */
+void HeapSiftDown(Heap *heap, int position)
+{
+	struct_heap_item item = heap->items[position];
+	int child;
+
+	while ((child = 2 * position + 1) < heap->size)
+	{
+		if (child + 1 < heap->size && heapItemLess(&heap->items[child + 1], &heap->items[child])) //take the smaller child
+			child++;
+		if (!heapItemLess(&heap->items[child], &item))
+			break;
+		heap->items[position] = heap->items[child];
+		position = child;
+	}
+	heap->items[position] = item;
+}
+
+struct_heap_item *HeapTop(Heap *heap)
+{
+	if (heap == NULL || heap->size == 0)
+		return NULL;
+	return &heap->items[0];
+}
+/* ************************* End of methods and functions for the binary heap ***************************** */
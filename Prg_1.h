@@ -1,5 +1,7 @@
 #define FIFONAME "/tmp/fifo_demo"
-#define MSGLENGTH 100
+#define MSGLENGTH 512
+#define RADIX_SORT_THRESHOLD 64 //sortByArrivalTimes uses the radix sort from this many processes upwards
+#define MERGE_SORT_RUN 16 //length of the runs the merge sort insertion sorts before merging
 
 
 typedef struct {
@@ -9,33 +11,402 @@ typedef struct {
 	int waitTime;
 	int remainingTime;
 	int turnAroundTime;
+	int priority; //lower numbers run first - only used by the priority policy
 } struct_process_info;
 
+/* the same processes as an array of struct_process_info, with every field in an array of its own - a loop that only
+ * reads one or two fields then only loads those from memory, and loads them in a way the compiler can vectorize */
+typedef struct {
+	int count; //number of processes
+	int *processId;
+	int *arriveTime;
+	int *burstTime;
+	int *remainingTime;
+	int *waitTime;
+	int *turnAroundTime;
+	int *priority;
+} struct_process_table;
+
 typedef struct Node_t {
 	struct_process_info *data;
 	struct Node_t *prev;
 } NODE;
 
+#define QUEUE_LINKED 0 //nodes are linked to each other through prev
+#define QUEUE_RING 1 //the index of each queued process is kept in a circular array
+
 /* the HEAD of the Queue, hold the amount of node's that are in the queue*/
 typedef struct Queue {
 	NODE *head;
 	NODE *tail;
 	int size;
 	int limit;
+	NODE *pool; //block of limit nodes handed out by AllocateNode
+	NODE *freeList; //nodes given back by ReleaseNode, linked through prev
+	int poolUsed; //number of nodes in the pool that have been handed out at least once
+	int type; //QUEUE_LINKED or QUEUE_RING
+	struct_process_info *processes; //QUEUE_RING only - the array the indices in ring refer to
+	int *ring; //QUEUE_RING only - limit process indices, in queue order from first
+	int first; //QUEUE_RING only - position in ring of the front of the queue
+	NODE frontNode; //QUEUE_RING only - node returned by front
 } Queue;
 
 Queue *ConstructQueue(int limit);
+Queue *ConstructQueueOfType(int limit, int type, struct_process_info *processes);
 void DestructQueue(Queue *queue);
+NODE *AllocateNode(Queue *pQueue);
+void ReleaseNode(Queue *pQueue, NODE *item);
 int Enqueue(Queue *pQueue, NODE *item);
 NODE *Dequeue(Queue *pQueue);
 int isEmpty(Queue* pQueue);
 NODE * front(Queue *pQueue);
 
+/* binary min-heap of process indices, used as the ready structure of the policies that pick the smallest key */
+typedef struct {
+	long long key;
+	int index; //index of the process in the array being scheduled - also breaks ties so earlier arrivals go first
+} struct_heap_item;
+
+typedef struct {
+	struct_heap_item *items;
+	int size;
+	int limit;
+} Heap;
+
+Heap *ConstructHeap(int limit);
+void DestructHeap(Heap *heap);
+int HeapPush(Heap *heap, long long key, int index);
+struct_heap_item HeapPop(Heap *heap);
+struct_heap_item *HeapTop(Heap *heap);
+void HeapSiftDown(Heap *heap, int position);
+int heapItemLess(const struct_heap_item *a, const struct_heap_item *b);
+
+/* binary workload file - a header followed by count fixed-size records in native byte order */
+#define WORKLOAD_MAGIC "RRWL"
+#define WORKLOAD_VERSION 2 //version 1 records have no priority
+
+typedef struct {
+	char magic[4]; //WORKLOAD_MAGIC
+	uint32_t version; //WORKLOAD_VERSION
+	uint64_t count; //number of records after the header
+} struct_workload_header;
+
+typedef struct {
+	int32_t arriveTime;
+	int32_t burstTime;
+	int32_t priority;
+} struct_workload_record;
+
+/* binary results file - a header page followed by one column of count int32 values per field, in native byte order.
+ * The header and every column start on a multiple of RESULTS_ALIGN bytes, so a memory-mapped column is an aligned
+ * array that can be given straight to summariseResults */
+#define RESULTS_MAGIC "RRRS"
+#define RESULTS_VERSION 1
+#define RESULTS_ALIGN 4096
+#define RESULTS_BLOCK_BYTES (1 << 20) //the columns are written this many bytes at a time
+
+#define RESULT_PROCESS_ID 0
+#define RESULT_ARRIVE_TIME 1
+#define RESULT_BURST_TIME 2
+#define RESULT_WAIT_TIME 3
+#define RESULT_TURNAROUND_TIME 4
+#define RESULT_COMPLETION_TIME 5 //arrive time + turnaround time
+#define RESULT_COLUMNS 6
+
+typedef struct {
+	char magic[4]; //RESULTS_MAGIC
+	uint32_t version; //RESULTS_VERSION
+	uint64_t count; //number of processes, the length of every column
+	uint32_t columns; //RESULT_COLUMNS
+	uint32_t valueBytes; //bytes per value - sizeof (int32_t)
+	uint64_t offset[RESULT_COLUMNS]; //position in the file of each column
+} struct_results_header;
+
+/* a results file mapped into memory by mapResults */
+typedef struct {
+	void *data; //the whole file
+	size_t length;
+	uint64_t count;
+	const int32_t *column[RESULT_COLUMNS]; //the columns inside data, indexed by RESULT_PROCESS_ID...
+} struct_results_file;
+
+#define STREAM_CHUNK_BYTES (1 << 20) //a streamed workload file is read this many bytes at a time
+
+/* a workload file read a chunk at a time, so that only the processes that have arrived are held in memory */
+typedef struct {
+	int fd;
+	const char *path; //used in the error messages
+	int binary; //1 - the binary format, 0 - text
+	size_t recordSize; //binary only - bytes per record, which depends on the version
+	unsigned long long remaining; //binary only - records not read yet
+	char *buffer; //STREAM_CHUNK_BYTES bytes read from the file
+	size_t start; //first byte of buffer that has not been parsed
+	size_t end; //bytes of buffer that have been read from the file
+	int endOfFile; //1 once the file has been read to the end
+	size_t line; //text only - number of the last line parsed
+	int nextId; //id given to the next process read
+	int lastArrival; //arrive time of the last process read - the file must be sorted by arrive time
+} struct_workload_stream;
+
+/* processes kept by value in a circular array that doubles when it is full - the ready queue of a streamed schedule */
+typedef struct {
+	struct_process_info *items;
+	size_t capacity;
+	size_t first; //position of the front of the queue
+	size_t size;
+} struct_live_queue;
+
+#define LIVE_QUEUE_START 1024 //processes a live queue has room for before it first grows
+
+/* log-linear histogram used as a streaming quantile sketch - values below 2^HISTOGRAM_PRECISION_BITS are counted
+ * exactly and every larger power of two is split into 2^(HISTOGRAM_PRECISION_BITS - 1) buckets, so a quantile is
+ * within 1/64 of the true value whatever the number of processes */
+#define HISTOGRAM_PRECISION_BITS 7
+#define HISTOGRAM_BUCKETS ((1 << HISTOGRAM_PRECISION_BITS) + (31 - HISTOGRAM_PRECISION_BITS) * (1 << (HISTOGRAM_PRECISION_BITS - 1)))
+
+/* statistics collected as each process completes */
+typedef struct {
+	long long count; //number of completed processes
+	long long totalWaitTime; //64 bits so that large workloads do not overflow
+	long long totalTurnAroundTime;
+	long long busyTime; //time the CPUs spent running processes
+	long long overheadTime; //time the CPUs spent switching between processes and dispatching them
+	long long dispatches; //number of times a process was started
+	long long contextSwitches; //dispatches of a different process from the one that ran last on the CPU
+	long long preemptions; //number of times a process was stopped before it completed
+	int numOfCores; //CPUs the processes were run on, the utilisation is busyTime over the elapsed time of every core
+	double meanWaitTime, m2WaitTime; //Welford running mean and sum of squared differences
+	double meanTurnAroundTime, m2TurnAroundTime;
+	int firstArrival; //arrive time of the first process
+	int lastCompletion; //time the last process completed
+	long long waitHistogram[HISTOGRAM_BUCKETS];
+	long long turnAroundHistogram[HISTOGRAM_BUCKETS];
+} struct_sim_stats;
+
+/* summary of the results of a schedule, found in one pass by summariseResults */
+typedef struct {
+	long long count;
+	long long totalBurstTime, totalWaitTime, totalTurnAroundTime;
+	int minWaitTime, maxWaitTime;
+	int minTurnAroundTime, maxTurnAroundTime;
+	long long badWaitTimes; //processes whose wait time is not their turnaround time less their burst time
+	long long badTurnAroundTimes; //processes whose turnaround time is less than their burst time
+	long long waitHistogram[HISTOGRAM_BUCKETS];
+	long long turnAroundHistogram[HISTOGRAM_BUCKETS];
+} struct_result_summary;
+
+typedef void (*result_kernel_function)(const int *burstTime, const int *waitTime, const int *turnAroundTime, long long count,
+                                       struct_result_summary *summary);
+
+/* one way of computing a struct_result_summary - every kernel gives exactly the same results */
+typedef struct {
+	const char *name;
+	result_kernel_function run;
+	int (*supported)(void); //1 if the CPU running the program has the instructions the kernel uses
+} struct_result_kernel;
+
+extern const struct_result_kernel resultKernels[]; //fastest first, ending with the scalar kernel and then a NULL name
+
+/* schedule events passed to the trace function of struct_sim_config */
+#define TRACE_DISPATCH 0 //the process starts running
+#define TRACE_PREEMPT 1 //the process stops running before it has completed
+#define TRACE_COMPLETE 2 //the process has completed
+
+#define CACHE_LINE 64 //data written by different threads or cores is kept this far apart
+
+/* results of one CPU of a multi-core simulation */
+typedef struct {
+	long long busyTime; //time the core spent running processes
+	long long dispatches; //number of times a process was started on the core
+	long long migrations; //dispatches of a process that last ran on a different core
+	long long steals; //BALANCE_STEAL only - processes taken from the run queue of another core
+} struct_core_stats;
+
+#define BALANCE_GLOBAL 0 //every core takes the next process from one shared run queue
+#define BALANCE_STEAL 1 //every core has its own run queue and takes from another core's queue when its own is empty
+
+/* a list of processes kept by index, linked through an array of next indices shared by every list */
+typedef struct {
+	int head; //first process, -1 when empty
+	int tail; //last process
+	int length;
+} struct_run_queue;
+
+/* one CPU of scheduleMultiCore - aligned to a cache line so that cores run by different threads never share one */
+typedef struct {
+	_Alignas(CACHE_LINE) struct_run_queue runQueue; //BALANCE_STEAL only - processes waiting for this core
+	int running; //index of the process running on the core, -1 when idle
+	int lastRan; //id of the process that ran last on the core, -1 before the first dispatch
+	struct_core_stats stats;
+} struct_core;
+
+/* state of one run of scheduleMultiCore */
+typedef struct {
+	struct_core *cores;
+	int numOfCores;
+	struct_run_queue globalQueue; //BALANCE_GLOBAL only - processes waiting for any core
+	int *next; //next process in the same run queue, one per process
+	int *lastCore; //core each process last ran on, -1 before it first runs
+	int *idleCores; //stack of the cores that are not running a process
+	int numOfIdle;
+	uint64_t *queuedCores; //BALANCE_STEAL only - one bit per core, set while the core's run queue is not empty
+	int nextCore; //BALANCE_STEAL only - core the next arrival is queued on
+	int waiting; //number of processes in the run queues
+	Heap *events; //end of the time slice of every running core, ordered by time and then core
+} struct_multicore;
+
+typedef void (*trace_function)(void *context, int event, int timeCounter, const struct_process_info *process);
+
+/* settings every scheduling policy is run with */
+typedef struct {
+	int timeQuantum; //the longest time a process runs before it is preempted - 0 for never
+	int agingInterval; //priority only - a waiting process gains one priority level every agingInterval time units, 0 for no aging
+	struct_sim_stats *stats; //every completed process is added to these statistics, NULL for none
+	trace_function trace; //called for every dispatch, preemption and completion, NULL for none
+	void *traceContext; //passed to trace
+	int numOfCores; //scheduleMultiCore only - number of CPUs
+	int balancing; //scheduleMultiCore only - BALANCE_GLOBAL or BALANCE_STEAL
+	struct_core_stats *coreStats; //scheduleMultiCore only - numOfCores results, one per CPU, NULL for none
+	int switchCost; //time taken to switch the CPU to a different process - every policy but rr-tick
+	int dispatchLatency; //time taken by the dispatcher on every dispatch, even of the process that ran last
+} struct_sim_config;
+
+/* the FIFO and the ring carry frames - a header followed by length bytes of payload */
+#define FRAME_TRACE 1 //payload is a batch of struct_trace_event
+#define FRAME_SUMMARY 2 //payload is the text of the statistics
+#define FRAME_TEXT 3 //payload is more text for the output file that is not echoed to the terminal
+#define FRAME_BATCH_BYTES 4096 //largest frame, header included - no more than PIPE_BUF so every frame is written in one go
+#define FRAME_READ_BYTES 65536 //thread 2 reads the FIFO or the ring this many bytes at a time
+
+typedef struct {
+	uint32_t type; //FRAME_TRACE or FRAME_SUMMARY
+	uint32_t length; //number of bytes after the header
+} struct_frame_header;
+
+typedef struct {
+	int32_t event; //TRACE_DISPATCH, TRACE_PREEMPT or TRACE_COMPLETE
+	int32_t timeCounter;
+	int32_t processId;
+	int32_t remainingTime;
+	int32_t arriveTime;
+	int32_t burstTime;
+	int32_t waitTime; //TRACE_COMPLETE only
+	int32_t turnAroundTime; //TRACE_COMPLETE only
+} struct_trace_event;
+
+#define RING_BYTES (1 << 20) //size of the data of the ring between the two threads - must be a power of two
+#define RING_MAGIC 0x474e4952 //"RING" - set once the ring is ready, so a process attaching to shared memory knows it can be used
+#define RING_ATTACH_TRIES 100 //AttachSharedRing tries this many times, 100 ms apart, for the ring to be created
+#define RING_TRACE_SCHEDULE 1 //flag of a shared ring - the producer writes every dispatch, preemption and completion (-g)
+#define RING_PROCESS_RESULTS 2 //flag of a shared ring - the completions are written as the results of each process (-r)
+
+/*
+ * single producer, single consumer byte ring - head and tail count every byte ever written and read, so the ring is
+ * empty when they are equal and the position in data is the count modulo capacity. The header and data are one block
+ * of memory without pointers, so the ring can be placed in memory shared with another process.
+ */
+typedef struct {
+	atomic_size_t head; //bytes written - only changed by the producer
+	char padHead[CACHE_LINE - sizeof (atomic_size_t)]; //keep head and tail on different cache lines
+	atomic_size_t tail; //bytes read - only changed by the consumer
+	char padTail[CACHE_LINE - sizeof (atomic_size_t)];
+	atomic_int consumerWaiting; //1 while the consumer is waiting on dataReady
+	atomic_int producerWaiting; //1 while the producer is waiting on spaceReady
+	atomic_int closed; //1 once the producer has written everything
+	atomic_uint magic; //RING_MAGIC once the ring has been set up
+	unsigned int flags; //RING_TRACE_SCHEDULE and RING_PROCESS_RESULTS, so another process writes what was asked for
+	size_t capacity; //bytes in data, a power of two
+	sem_t dataReady; //doorbell posted by the producer when the consumer is waiting
+	sem_t spaceReady; //doorbell posted by the consumer when the producer is waiting
+	char data[]; //capacity bytes
+} struct_ring;
+
+#define TRANSPORT_RING 0 //the two threads share a ring in memory
+#define TRANSPORT_FIFO 1 //the two threads are connected by the named FIFO
+#define TRANSPORT_SHM 2 //the two threads share a ring in POSIX shared memory
+#define TRANSPORT_EXPORT 3 //the ring is in named POSIX shared memory and is read by a separate reporting process
+
+/* stages of a run timed with -T - each is timed by the one thread that runs it */
+#define STAGE_LOAD 0 //main - reading the workload file given with -i
+#define STAGE_INPUT 1 //thread 1 - asking for the processes, or opening the workload streamed with -m
+#define STAGE_SAVE_WORKLOAD 2 //thread 1 - saving the workload with -w
+#define STAGE_FIFO_SETUP 3 //thread 1 - creating the FIFO and waiting for thread 2 to open it
+#define STAGE_SORT 4 //thread 1 - sorting the processes by arrive time
+#define STAGE_SCHEDULE 5 //thread 1 - running the policy, including sending the trace frames of -g and -r
+#define STAGE_SAVE_RESULTS 6 //thread 1 - saving the results with -o
+#define STAGE_REPORT 7 //thread 1 - formatting the statistics and sending them
+#define STAGE_WRITE_FILE 8 //thread 2 - from when it starts until it has written the last frame
+#define STAGE_CLOSE 9 //main - flushing and closing the output file
+#define STAGES 10
+
+#define THREAD_1 0
+#define THREAD_2 1
+
+/* where the wall-clock time of a run went, measured with CLOCK_MONOTONIC - every time is in nanoseconds */
+typedef struct {
+	struct timespec start; //when main started - the start of every stage is measured from here
+	long long stageStart[STAGES]; //-1 for a stage that did not run
+	long long stageTime[STAGES];
+	long long semaphoreWait[2]; //time THREAD_1 and THREAD_2 waited in sem_wait for the FIFO
+	long long sendTime; //thread 1 - time writing frames to the FIFO or ring, including waiting for room in it
+	long long framesSent;
+	long long bytesSent;
+	long long receiveTime; //thread 2 - time reading the FIFO or ring, including waiting for thread 1
+	long long fileTime; //thread 2 - time turning frames into text and writing them to the output file
+} struct_timing;
+
+/* collects trace events into a frame and writes the frame when it is full */
+typedef struct {
+	int fd; //where the frames are written when ring is NULL
+	struct_ring *ring; //where the frames are written, NULL to use fd
+	int traceSchedule; //1 - every event is written, 0 - only TRACE_COMPLETE events
+	char buffer[FRAME_BATCH_BYTES]; //a struct_frame_header followed by the events collected so far
+	size_t used; //bytes of buffer in use, header included
+	long long events; //number of events written
+	struct_timing *timing; //the time spent writing frames is added to timing->sendTime, NULL to not measure it
+} struct_frame_writer;
+
+#define MLFQ_LEVELS 3 //number of queues used by the multilevel feedback queue policy
+
+/* a scheduling policy - run() fills in the wait and turnaround time of every process in an array sorted by arrive time */
+typedef struct {
+	const char *name;
+	void (*run)(struct_process_info *processes, int arraySize, const struct_sim_config *config);
+	int usesPriority; //1 if the processes need a priority
+	int usesQuantum; //1 if the results depend on the time quantum
+	const char *description;
+} struct_policy;
+
+extern const struct_policy policies[]; //every policy that can be chosen with -p, ending with a NULL name
+
+/* options given on the command line that change how the simulation is run */
+typedef struct {
+	const struct_policy *policy; //the scheduling policy to run
+	int agingInterval; //passed to the policy in struct_sim_config
+	char *inputFile; //workload file to read the processes from instead of asking the user, NULL to ask
+	char *binaryFile; //file to save the workload to in the binary format, NULL to not save it
+	int traceSchedule; //1 - stream every dispatch, preemption and completion into the output file
+	int processResults; //1 - write the results of every process into the output file as it completes
+	int transport; //TRANSPORT_RING, TRANSPORT_FIFO, TRANSPORT_SHM or TRANSPORT_EXPORT
+	int numOfCores; //1 to run the policy, more to run round robin on this many CPUs with scheduleMultiCore
+	int balancing; //BALANCE_GLOBAL or BALANCE_STEAL
+	int switchCost; //passed to the policy in struct_sim_config
+	int dispatchLatency; //passed to the policy in struct_sim_config
+	int streamInput; //1 - read the workload file a chunk at a time while the schedule runs instead of loading it first
+	char *resultsFile; //file to write the results of every process to in the binary results format, NULL to not write it
+	struct_timing *timing; //-T - filled in by main and both threads, NULL to not time the run
+	int execute; //1 - also run the round robin schedule on real threads and compare it with the simulation
+} struct_options;
+
 typedef struct {
 	sem_t *sem_write_fifo;
 	sem_t *sem_read_fifo;
 	int timeQuantum;
 	int *fifofd;
+	struct_ring *ring; //the results are written to the ring, NULL to use the FIFO
+	struct_options *options;
+	struct_process_info *processes; //processes loaded from options->inputFile, NULL to ask the user for them
+	int numOfProcesses;
 } struct_thread1_info;
 
 typedef struct {
@@ -43,23 +414,234 @@ typedef struct {
 	sem_t *sem_write_fifo;
 	FILE *fp;
 	int *fifofd;
+	struct_ring *ring; //the results are read from the ring, NULL to use the FIFO
+	struct_options *options;
 } struct_thread2_info;
 
-void roundRobin(struct_process_info *processes, int arraySize, int timeQuantum);
+#define SWEEP_LINE_LENGTH 160 //longest line of the sweep table
+
+/* one simulation of a sweep and its results */
+typedef struct {
+	const struct_policy *policy;
+	int timeQuantum;
+	double avgWaitTime;
+	double avgTurnAroundTime;
+	long long contextSwitches;
+	long long overheadTime; //time spent switching and dispatching
+	double throughput; //processes completed per time unit
+	double effectiveUtilisation; //percentage of the elapsed time spent running processes rather than switching
+} struct_sweep_job;
+
+/* shared by the worker threads of a sweep */
+typedef struct {
+	struct_process_info *processes; //sorted by arrive time, only read by the workers
+	int numOfProcesses;
+	int agingInterval;
+	int switchCost;
+	int dispatchLatency;
+	struct_sweep_job *jobs;
+	int numOfJobs;
+	int nextJob; //next job no worker has taken yet
+	pthread_mutex_t lock; //protects nextJob
+} struct_sweep_info;
+
+/* -e runs the round robin schedule for real, with a thread per process doing CPU work for its burst */
+#define EXECUTE_UNIT_NS 1000000LL //one time unit of the simulation is run as one millisecond
+#define EXECUTE_MAX_PROCESSES 1024 //every process has a thread of its own, so -e is for small workloads
+#define EXECUTE_STACK_BYTES (64 * 1024) //the workers only spin, so they need very little stack
+
+#define WORKER_PARKED 0 //waiting on wake for the dispatcher to give it the CPU
+#define WORKER_RUNNING 1
+#define WORKER_EXIT 2
+
+struct struct_executor;
+
+/* the thread that runs one process */
+typedef struct {
+	pthread_t thread;
+	struct struct_executor *executor;
+	pthread_mutex_t lock; //protects state and the times
+	pthread_cond_t wake; //signalled by the dispatcher when it sets state to WORKER_RUNNING or WORKER_EXIT
+	pthread_cond_t changed; //signalled by the worker when it starts running and when it sets state back to WORKER_PARKED
+	int state;
+	atomic_int preempt; //set by the dispatcher when the time quantum expires, checked by the worker as it spins
+	long long remaining; //time the process still needs to run, in nanoseconds
+	long long dispatchedAt; //when the dispatcher last woke the worker - every time is in nanoseconds from the start
+	long long startedAt; //when the worker started running after it was last woken, -1 until it has
+	long long parkedAt; //when the worker last stopped running
+} struct_worker;
+
+/* a round robin schedule run on threads, and what was measured while it ran */
+typedef struct struct_executor {
+	struct timespec start; //the time that arrive time 0 stands for
+	struct_worker *workers; //one per process
+	int count;
+	int realTime; //1 if the dispatcher and the workers run with SCHED_FIFO, 0 if it is not permitted
+	int workerCpu; //CPU every worker is pinned to, -1 if the affinity could not be set
+	int dispatcherCpu; //CPU the dispatcher is pinned to, -1 if the affinity could not be set
+	double *waitTime; //measured for each process, in time units
+	double *turnAroundTime;
+	long long dispatches;
+	long long preemptions;
+	long long totalDispatchLatency; //time from the dispatcher waking a worker to the worker running, in nanoseconds
+	long long maxDispatchLatency;
+	long long dispatchLatency[HISTOGRAM_BUCKETS]; //the same in microseconds
+	long long totalPreemptLatency; //time from the end of a time quantum to the worker stopping, in nanoseconds
+	long long maxPreemptLatency;
+	long long preemptLatency[HISTOGRAM_BUCKETS];
+} struct_executor;
+
+void roundRobin(struct_process_info *processes, int arraySize, const struct_sim_config *config);
+void roundRobinEventDriven(struct_process_info *processes, int arraySize, int timeQuantum);
+int admitArrivals(Queue *processQueue, struct_process_info *processes, int arraySize, int *nextArrival, int beforeTime,
+                  struct_sim_stats *stats);
+int admitArrivalsToHeap(Heap *heap, struct_process_info *processes, int arraySize, int *nextArrival, int beforeTime,
+                        long long (*key)(struct_process_info *process, const struct_sim_config *config), const struct_sim_config *config);
+void completeProcess(struct_process_info *process, int timeCounter, struct_sim_stats *stats);
+void preemptProcess(const struct_sim_config *config, int timeCounter, const struct_process_info *process);
+int dispatchOverhead(const struct_sim_config *config, const struct_process_info *process, int *lastRan);
+void initialiseStats(struct_sim_stats *stats);
+void recordCompletion(struct_sim_stats *stats, struct_process_info *process, int completionTime);
+void mergeStats(struct_sim_stats *total, const struct_sim_stats *part);
+int histogramBucket(int value);
+int histogramBucketValue(int bucket);
+int statsQuantile(const long long *histogram, long long count, double quantile);
+double statsStdDev(double m2, long long count);
+int formatStats(char *buffer, size_t length, const struct_sim_stats *stats);
+void summariseResults(const int *burstTime, const int *waitTime, const int *turnAroundTime, long long count,
+                      struct_result_summary *summary);
+const struct_result_kernel *chooseResultKernel(void);
+void initialiseResultSummary(struct_result_summary *summary);
+void summariseResultsRange(const int *burstTime, const int *waitTime, const int *turnAroundTime, long long first,
+                           long long count, struct_result_summary *summary);
+void summariseResultsScalar(const int *burstTime, const int *waitTime, const int *turnAroundTime, long long count,
+                            struct_result_summary *summary);
+int resultKernelAlwaysSupported(void);
+#if defined(__x86_64__) || defined(__i386__)
+void summariseResultsSSE41(const int *burstTime, const int *waitTime, const int *turnAroundTime, long long count,
+                           struct_result_summary *summary);
+void summariseResultsAVX2(const int *burstTime, const int *waitTime, const int *turnAroundTime, long long count,
+                          struct_result_summary *summary);
+int resultKernelSSE41Supported(void);
+int resultKernelAVX2Supported(void);
+#endif
+int resultSummaryText(char *buffer, size_t length, const struct_result_summary *summary);
+int formatCoreStats(char *buffer, size_t length, const struct_core_stats *coreStats, int core, const struct_sim_stats *stats);
+void traceEvent(const struct_sim_config *config, int event, int timeCounter, const struct_process_info *process);
+void initialiseFrameWriter(struct_frame_writer *writer, int fd, struct_ring *ring, int traceSchedule);
+void traceToFrames(void *context, int event, int timeCounter, const struct_process_info *process);
+int flushFrame(struct_frame_writer *writer);
+int sendFrame(struct_frame_writer *writer, size_t length);
+int writeFrame(struct_frame_writer *writer, uint32_t type, const void *payload, uint32_t length);
+int writeAll(int fd, const void *buffer, size_t length);
+int readFrames(int fd, struct_ring *ring, FILE *fp, const struct_options *options);
+int writeTraceEvents(FILE *fp, const struct_trace_event *events, size_t count, const struct_options *options);
+size_t ringBytes(size_t capacity);
+int initialiseRing(struct_ring *ring, size_t capacity, int shared);
+struct_ring *ConstructRing(size_t capacity);
+void DestructRing(struct_ring *ring);
+int RingWrite(struct_ring *ring, const void *buffer, size_t length);
+ssize_t RingRead(struct_ring *ring, void *buffer, size_t length);
+void RingClose(struct_ring *ring);
+struct_ring *CreateSharedRing(const char *name, size_t capacity, unsigned int flags);
+struct_ring *AttachSharedRing(const char *name);
+int ReleaseSharedRing(struct_ring *ring, const char *name);
+void DetachSharedRing(struct_ring *ring);
+void scheduleMultiCore(struct_process_info *processes, int arraySize, const struct_sim_config *config);
+int admitArrivalsToRunQueues(struct_multicore *sim, struct_process_info *processes, int arraySize, int *nextArrival,
+                             int beforeTime, const struct_sim_config *config);
+void queueOnCore(struct_multicore *sim, int core, int index, const struct_sim_config *config);
+int takeForCore(struct_multicore *sim, int core, const struct_sim_config *config);
+int findQueuedCore(const struct_multicore *sim, int from);
+void dispatchOnCore(struct_multicore *sim, int core, int index, struct_process_info *processes, int timeCounter,
+                    const struct_sim_config *config);
+void runQueuePush(struct_run_queue *queue, int *next, int index);
+int runQueuePop(struct_run_queue *queue, int *next);
+const struct_policy *findPolicy(const char *name);
+void runToCompletionFromHeap(struct_process_info *processes, int arraySize, const struct_sim_config *config,
+                             long long (*key)(struct_process_info *process, const struct_sim_config *config));
+void scheduleRoundRobin(struct_process_info *processes, int arraySize, const struct_sim_config *config);
+void scheduleRoundRobinTicks(struct_process_info *processes, int arraySize, const struct_sim_config *config);
+void firstComeFirstServed(struct_process_info *processes, int arraySize, const struct_sim_config *config);
+void shortestJobFirst(struct_process_info *processes, int arraySize, const struct_sim_config *config);
+void shortestRemainingTimeFirst(struct_process_info *processes, int arraySize, const struct_sim_config *config);
+void priorityScheduling(struct_process_info *processes, int arraySize, const struct_sim_config *config);
+void multilevelFeedbackQueue(struct_process_info *processes, int arraySize, const struct_sim_config *config);
+long long burstTimeKey(struct_process_info *process, const struct_sim_config *config);
+long long remainingTimeKey(struct_process_info *process, const struct_sim_config *config);
+long long agedPriorityKey(struct_process_info *process, const struct_sim_config *config);
 int writeDataToFile(FILE *f, char *buffer);
 int getNumber(int *number);
 void cleanInput(void);
 void instructions(void);
+void usage(void);
 double averageWaitTime(struct_process_info *processes, int arraySize);
 double averageTurnAroundTime(struct_process_info *processes, int arraySize);
+struct_process_table *ConstructProcessTable(int count);
+void DestructProcessTable(struct_process_table *table);
+void processTableFromArray(struct_process_table *table, const struct_process_info *processes);
+void processTableToArray(const struct_process_table *table, struct_process_info *processes);
+void processTableEntry(const struct_process_table *table, int index, struct_process_info *process);
+void scheduleRoundRobinTable(struct_process_table *table, const struct_sim_config *config);
+double averageWaitTimeTable(const struct_process_table *table);
+double averageTurnAroundTimeTable(const struct_process_table *table);
+void summariseProcessTable(const struct_process_table *table, struct_result_summary *summary);
+int admitTableArrivals(struct_process_table *table, int *ring, int first, int *size, int *nextArrival, int beforeTime,
+                       struct_sim_stats *stats);
+long long sumOfTimes(const int *times, int count);
 int sortByArrivalTimes(struct_process_info *processes, int arraySize);
-void initialiseProcesses(struct_process_info *processes, int arraySize);
+int mergeSortByArrivalTimes(struct_process_info *processes, int arraySize);
+int radixSortByArrivalTimes(struct_process_info *processes, int arraySize);
+void initialiseProcesses(struct_process_info *processes, int arraySize, int askPriority);
+struct_process_info *askForProcesses(int *numOfProcesses, int askPriority);
+void executeAndReport(struct_frame_writer *frames, struct_process_info *processes, int arraySize, int timeQuantum);
+int executeRoundRobin(struct_process_info *processes, int arraySize, int timeQuantum, struct_executor *executor);
+int admitExecutorArrivals(const struct_process_info *processes, int arraySize, int *nextArrival, int *ring, int first,
+                          int *size, long long time);
+void *workerRoutine(struct_worker *worker);
+void dispatchWorker(struct_executor *executor, struct_worker *worker, int timeQuantum);
+long long executorTime(const struct_executor *executor);
+void executorDeadline(const struct_executor *executor, long long time, struct timespec *deadline);
+int pinThread(pthread_t thread, int cpu);
+void DestructExecutor(struct_executor *executor);
+int formatExecutedProcess(char *buffer, size_t length, const struct_process_info *process, const struct_executor *executor,
+                          int index);
+int formatExecution(char *buffer, size_t length, const struct_executor *executor, const struct_process_info *processes,
+                    int arraySize);
+int sweepMain(char *quanta, char *outputFile, char *policyNames, struct_options *options);
+int parseQuanta(const char *text, int **quanta, int *count);
+int loadWorkload(const char *path, struct_process_info **processes, int *arraySize);
+int parseWorkloadText(const char *text, size_t length, struct_process_info **processes, int *arraySize);
+int parseWorkloadBinary(const char *data, size_t length, struct_process_info **processes, int *arraySize);
+int saveWorkloadBinary(const char *path, struct_process_info *processes, int arraySize);
+int saveResultsBinary(const char *path, const struct_process_info *processes, int arraySize);
+size_t fillResultColumn(int32_t *values, const struct_process_info *processes, int first, int count, int column);
+int mapResults(const char *path, struct_results_file *results);
+void unmapResults(struct_results_file *results);
+int parseWorkloadLine(const char *position, const char *end, size_t line, long values[3]);
+void initialiseProcess(struct_process_info *process, int processId, int arriveTime, int burstTime, int priority);
+struct_workload_stream *openWorkloadStream(const char *path);
+int readWorkloadStream(struct_workload_stream *stream, struct_process_info *process);
+int fillWorkloadStream(struct_workload_stream *stream);
+void closeWorkloadStream(struct_workload_stream *stream);
+int scheduleRoundRobinStream(struct_workload_stream *stream, const struct_sim_config *config);
+int admitStreamArrivals(struct_workload_stream *stream, struct_live_queue *queue, struct_process_info *next, int haveNext,
+                        int beforeTime, const struct_sim_config *config);
+int LiveQueuePush(struct_live_queue *queue, const struct_process_info *process);
+void LiveQueuePop(struct_live_queue *queue, struct_process_info *process);
 void initialiseFifo(void);
 int writeToFile(FILE *f, char *buffer);
 int isPositiveNumber(char number[]);
 int initialiseSemaphores(sem_t *sem_write, sem_t *sem_read);
+void initialiseTiming(struct_timing *timing);
+long long nanosecondsSince(const struct timespec *start);
+void beginStage(struct_timing *timing, int stage);
+void endStage(struct_timing *timing, int stage);
+void waitSemaphore(sem_t *semaphore, struct_timing *timing, int thread);
+int formatTiming(char *buffer, size_t length, const struct_timing *timing);
 void unLinkAllSemaphores(void);
 void printProcesses(struct_process_info *processes, int arraySize, int timeQuantum);
 
 void *thread1_routine(struct_thread1_info * data);
 void *thread2_routine(struct_thread2_info * data);
+void *sweepWorker_routine(struct_sweep_info *sweep);
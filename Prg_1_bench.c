@@ -0,0 +1,621 @@
+/*! @file
+ *
+ *  @brief This is a benchmark program for the scheduling primitives used by Prg_1.
+ *
+ *  This times the functions from Prg_1.c directly on generated processes, without the prompts, the FIFO or the threads.
+ *
+ *  To compile this file - write in the terminal : gcc -O2 -DPRG_1_NO_MAIN -o Prg_1_bench Prg_1_bench.c Prg_1.c -lpthread -lrt -lm
+ *  then write in the terminal: ./Prg_1_bench sort (or queue, or table, or results, or dump, or schedule [seed])
+ *
+ *  schedule runs every policy on workloads with Poisson arrivals and exponential, bimodal or Pareto burst times, and
+ *  prints one JSON object with the time per simulated tick, the time per context switch and the peak memory of each
+ *  run, so that runs before and after a change can be compared.
+ *
+ *  table compares round robin and the averages over an array of struct_process_info, which scheduleRoundRobin copies
+ *  into a table and back, with the same work straight on a struct_process_table, on up to 1e7 processes.
+ *
+ *  results times every summariseResults kernel the CPU supports on 1e8 results and checks that they all give the same
+ *  summary.
+ *
+ *  dump writes the results of a 1e7 process schedule as formatted text and with saveResultsBinary, then maps the
+ *  binary file back and checks every column.
+ *
+ */
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <time.h>
+#include <math.h>
+#include <stdint.h>
+#include <stdatomic.h>
+#include <unistd.h>
+#include <sys/types.h>
+#include <sys/stat.h>
+#include <sys/resource.h>
+#include <pthread.h>
+#include <semaphore.h>
+#include "Prg_1.h"
+
+typedef int (*sort_function)(struct_process_info *processes, int arraySize);
+
+/* burst time distributions of generateWorkload */
+#define BURST_EXPONENTIAL 0 //mean BURST_MEAN
+#define BURST_BIMODAL 1 //mostly short bursts with some long ones
+#define BURST_PARETO 2 //heavy tailed, a few bursts are very long
+#define BURST_MEAN 10 //mean of the exponential bursts, roughly the mean of the others
+#define BURST_MAX 1000000 //longest burst a Pareto burst is cut to
+#define SCHEDULE_LOAD 0.9 //arrival rate as a fraction of the rate the CPU can complete processes at
+#define SCHEDULE_QUANTUM 4
+#define RESULTS_COUNT 100000003 //results summarised by the results benchmark - not a multiple of any vector width
+#define DUMP_COUNT 10000000 //processes whose results are written by the dump benchmark
+#define DUMP_PATH "/tmp/Prg_1_bench.results" //file the dump benchmark writes, removed when it is done
+#define TICK_LOOP_LIMIT 10000 //the tick loop takes time for every tick, so it is only run on workloads up to this size
+
+void benchmarkSorts(void);
+void benchmarkQueues(void);
+void benchmarkSchedules(unsigned int seed);
+void benchmarkTables(void);
+void benchmarkResults(void);
+void benchmarkDump(void);
+void countDispatch(void *context, int event, int timeCounter, const struct_process_info *process);
+double secondsSince(struct timespec *start);
+unsigned int nextRandom(unsigned int *state);
+double nextUniform(unsigned int *state);
+void generateProcesses(struct_process_info *processes, int arraySize, int maxArriveTime, unsigned int seed);
+void generateWorkload(struct_process_info *processes, int arraySize, int bursts, unsigned int seed);
+long peakMemoryKB(void);
+
+int main(int argc, char* argv[])
+{
+	if (argc < 2 || argc > 3 || (argc == 3 && strcmp(argv[1], "schedule") != 0))
+	{
+		printf("usage: ./Prg_1_bench sort|queue|table|results|dump|schedule [seed]\n");
+		return -1;
+	}
+	if (strcmp(argv[1], "sort") == 0)
+		benchmarkSorts();
+	else if (strcmp(argv[1], "queue") == 0)
+		benchmarkQueues();
+	else if (strcmp(argv[1], "table") == 0)
+		benchmarkTables();
+	else if (strcmp(argv[1], "results") == 0)
+		benchmarkResults();
+	else if (strcmp(argv[1], "dump") == 0)
+		benchmarkDump();
+	else if (strcmp(argv[1], "schedule") == 0)
+		benchmarkSchedules(argc == 3 ? strtoul(argv[2], NULL, 10) : 12345);
+	else
+	{
+		printf("Unknown benchmark: %s\n", argv[1]);
+		return -1;
+	}
+	return 0;
+}
+
+/*
+ * @brief - benchmarkSorts - times the merge sort and the radix sort on 1e3 to 1e7 processes
+ *
+ * Every sort gets the same generated processes. The arrive times are spread over ten times the number of processes
+ * so there are still ties to keep in order, and each result is checked to be sorted and stable.
+ */
+void benchmarkSorts(void)
+{
+	const char *names[] = {"merge", "radix"};
+	sort_function sorts[] = {mergeSortByArrivalTimes, radixSortByArrivalTimes};
+	struct_process_info *processes;
+	struct timespec start;
+	double seconds;
+	int arraySize, sort, index, sorted;
+
+	printf("%10s %8s %12s %12s\n", "processes", "sort", "seconds", "ns/process");
+	for (arraySize = 1000; arraySize <= 10000000; arraySize *= 10)
+	{
+		processes = (struct_process_info*) malloc(sizeof (struct_process_info) * arraySize);
+		if (processes == NULL)
+		{
+			perror("malloc");
+			return;
+		}
+		for (sort = 0; sort < 2; sort++)
+		{
+			generateProcesses(processes, arraySize, arraySize * 10, 12345);
+			clock_gettime(CLOCK_MONOTONIC, &start);
+			sorts[sort](processes, arraySize);
+			seconds = secondsSince(&start);
+
+			sorted = 1;
+			for (index = 1; index < arraySize; index++) //equal arrive times must still be in process id order
+				if (processes[index - 1].arriveTime > processes[index].arriveTime ||
+				        (processes[index - 1].arriveTime == processes[index].arriveTime &&
+				         processes[index - 1].processId > processes[index].processId))
+					sorted = 0;
+			printf("%10d %8s %12.6f %12.2f%s\n", arraySize, names[sort], seconds, seconds * 1e9 / arraySize,
+			       sorted ? "" : "  NOT SORTED");
+		}
+		free(processes);
+	}
+}
+
+/*
+ * @brief - benchmarkQueues - compares the linked list queue with the ring queue for enqueue, requeue and dequeue
+ *
+ * The queue is filled with one node per process, every node is then requeued ten times in round robin order and
+ * finally the queue is emptied. Each requeue also touches the process the node points to, like roundRobin does.
+ * In the "recycled" runs every node of the pool has been released once in a random order first, the way nodes come
+ * back to the pool in a long simulation, so the linked list no longer walks the pool from start to end.
+ */
+void benchmarkQueues(void)
+{
+	const char *names[] = {"linked", "ring"};
+	int types[] = {QUEUE_LINKED, QUEUE_RING};
+	struct_process_info *processes;
+	Queue *queue;
+	NODE *node, **nodes;
+	struct timespec start;
+	double enqueueSeconds, requeueSeconds, dequeueSeconds;
+	long checksum;
+	unsigned int seed;
+	int arraySize, type, recycled, index, other, requeues;
+
+	printf("%10s %8s %9s %12s %12s %12s\n", "processes", "queue", "nodes", "enqueue ns", "requeue ns", "dequeue ns");
+	for (arraySize = 1000; arraySize <= 10000000; arraySize *= 10)
+	{
+		processes = (struct_process_info*) malloc(sizeof (struct_process_info) * arraySize);
+		nodes = (NODE**) malloc(sizeof (NODE*) * arraySize);
+		if (processes == NULL || nodes == NULL)
+		{
+			perror("malloc");
+			return;
+		}
+		generateProcesses(processes, arraySize, arraySize, 12345);
+		requeues = arraySize * 10;
+		for (recycled = 0; recycled < 2; recycled++)
+		{
+			for (type = 0; type < 2; type++)
+			{
+				queue = ConstructQueueOfType(arraySize, types[type], processes);
+				checksum = 0;
+				if (recycled) //hand every node out once and give them back in a random order
+				{
+					seed = 777;
+					for (index = 0; index < arraySize; index++)
+						nodes[index] = AllocateNode(queue);
+					for (index = arraySize - 1; index > 0; index--)
+					{
+						other = nextRandom(&seed) % (index + 1);
+						node = nodes[index];
+						nodes[index] = nodes[other];
+						nodes[other] = node;
+					}
+					for (index = 0; index < arraySize; index++)
+						ReleaseNode(queue, nodes[index]);
+				}
+
+				clock_gettime(CLOCK_MONOTONIC, &start);
+				for (index = 0; index < arraySize; index++)
+				{
+					node = AllocateNode(queue);
+					node->data = &processes[index];
+					Enqueue(queue, node);
+				}
+				enqueueSeconds = secondsSince(&start);
+
+				clock_gettime(CLOCK_MONOTONIC, &start);
+				for (index = 0; index < requeues; index++)
+				{
+					node = Dequeue(queue);
+					checksum += node->data->remainingTime;
+					Enqueue(queue, node);
+				}
+				requeueSeconds = secondsSince(&start);
+
+				clock_gettime(CLOCK_MONOTONIC, &start);
+				while (!isEmpty(queue))
+					ReleaseNode(queue, Dequeue(queue));
+				dequeueSeconds = secondsSince(&start);
+
+				DestructQueue(queue);
+				printf("%10d %8s %9s %12.2f %12.2f %12.2f  (checksum %ld)\n", arraySize, names[type],
+				       recycled ? "recycled" : "in order", enqueueSeconds * 1e9 / arraySize, requeueSeconds * 1e9 / requeues,
+				       dequeueSeconds * 1e9 / arraySize, checksum);
+			}
+		}
+		free(nodes);
+		free(processes);
+	}
+}
+
+/*
+ * @brief - benchmarkTables - times round robin and the averages over an array of processes and over a process table
+ *
+ * Both layouts get the same sorted workload with exponential bursts and are run without statistics or a trace, so
+ * only the scheduler touches the processes. scheduleRoundRobin runs the table loop too, so the array time is the
+ * cost of the copies into a table and back on top of the table time. The wait and turnaround time of every process
+ * is checked to be the same.
+ */
+void benchmarkTables(void)
+{
+	struct_process_info *workload, *processes;
+	struct_process_table *table;
+	struct_sim_config config;
+	struct timespec start;
+	double arraySchedule, arrayAverages, tableSchedule, tableAverages, arrayWait, tableWait;
+	int arraySize, index, same;
+
+	memset(&config, 0, sizeof config);
+	config.timeQuantum = SCHEDULE_QUANTUM;
+	printf("%10s %8s %14s %14s %14s\n", "processes", "layout", "schedule ns", "averages ns", "speedup");
+	for (arraySize = 100000; arraySize <= 10000000; arraySize *= 10)
+	{
+		workload = (struct_process_info*) malloc(sizeof (struct_process_info) * arraySize);
+		processes = (struct_process_info*) malloc(sizeof (struct_process_info) * arraySize);
+		table = ConstructProcessTable(arraySize);
+		if (workload == NULL || processes == NULL || table == NULL)
+		{
+			perror("malloc");
+			return;
+		}
+		generateWorkload(workload, arraySize, BURST_EXPONENTIAL, 12345);
+		sortByArrivalTimes(workload, arraySize);
+
+		memcpy(processes, workload, sizeof (struct_process_info) * arraySize);
+		clock_gettime(CLOCK_MONOTONIC, &start);
+		scheduleRoundRobin(processes, arraySize, &config);
+		arraySchedule = secondsSince(&start);
+		clock_gettime(CLOCK_MONOTONIC, &start);
+		arrayWait = averageWaitTime(processes, arraySize) + averageTurnAroundTime(processes, arraySize);
+		arrayAverages = secondsSince(&start);
+
+		processTableFromArray(table, workload);
+		clock_gettime(CLOCK_MONOTONIC, &start);
+		scheduleRoundRobinTable(table, &config);
+		tableSchedule = secondsSince(&start);
+		clock_gettime(CLOCK_MONOTONIC, &start);
+		tableWait = averageWaitTimeTable(table) + averageTurnAroundTimeTable(table);
+		tableAverages = secondsSince(&start);
+
+		same = arrayWait == tableWait;
+		for (index = 0; index < arraySize; index++)
+			if (processes[index].waitTime != table->waitTime[index] || processes[index].turnAroundTime != table->turnAroundTime[index])
+				same = 0;
+		printf("%10d %8s %14.2f %14.2f\n", arraySize, "array", arraySchedule * 1e9 / arraySize, arrayAverages * 1e9 / arraySize);
+		printf("%10d %8s %14.2f %14.2f %8.2fx %5.2fx%s\n", arraySize, "table", tableSchedule * 1e9 / arraySize,
+		       tableAverages * 1e9 / arraySize, arraySchedule / tableSchedule, arrayAverages / tableAverages,
+		       same ? "" : "  DIFFERENT RESULTS");
+		DestructProcessTable(table);
+		free(processes);
+		free(workload);
+	}
+}
+
+/*
+ * @brief - benchmarkResults - times each kernel of summariseResults on RESULTS_COUNT generated results
+ *
+ * The wait times are spread over every histogram bucket up to 2^30, one result in a thousand is made inconsistent
+ * and the count is not a multiple of the vector width, so every part of the kernels is checked against the scalar one.
+ * The speed is given as the bytes of the three arrays read per second, to compare with the bandwidth of the memory.
+ */
+void benchmarkResults(void)
+{
+	const struct_result_kernel *kernel;
+	struct_result_summary *summary, *scalar;
+	int *burstTime, *waitTime, *turnAroundTime;
+	struct timespec start;
+	double seconds;
+	unsigned int seed = 12345;
+	long long index, count = RESULTS_COUNT;
+
+	burstTime = (int*) malloc(sizeof (int) * count);
+	waitTime = (int*) malloc(sizeof (int) * count);
+	turnAroundTime = (int*) malloc(sizeof (int) * count);
+	summary = (struct_result_summary*) malloc(sizeof (struct_result_summary));
+	scalar = (struct_result_summary*) malloc(sizeof (struct_result_summary));
+	if (burstTime == NULL || waitTime == NULL || turnAroundTime == NULL || summary == NULL || scalar == NULL)
+	{
+		perror("malloc");
+		return;
+	}
+	for (index = 0; index < count; index++)
+	{
+		burstTime[index] = 1 + nextRandom(&seed) % 100;
+		waitTime[index] = nextRandom(&seed) >> (2 + nextRandom(&seed) % 30); //every power of two up to 2^30
+		turnAroundTime[index] = waitTime[index] + burstTime[index];
+		if (index % 1000 == 999)
+			turnAroundTime[index] -= 1 + nextRandom(&seed) % 200;
+	}
+
+	printf("%10s %8s %12s %12s %s\n", "results", "kernel", "seconds", "GB/s", "");
+	summariseResultsScalar(burstTime, waitTime, turnAroundTime, count, scalar);
+	for (kernel = resultKernels; kernel->name != NULL; kernel++)
+	{
+		if (!kernel->supported())
+		{
+			printf("%10lld %8s %12s\n", count, kernel->name, "unsupported");
+			continue;
+		}
+		clock_gettime(CLOCK_MONOTONIC, &start);
+		kernel->run(burstTime, waitTime, turnAroundTime, count, summary);
+		seconds = secondsSince(&start);
+		printf("%10lld %8s %12.6f %12.2f%s\n", count, kernel->name, seconds, 3.0 * sizeof (int) * count / seconds / 1e9,
+		       memcmp(summary, scalar, sizeof (struct_result_summary)) == 0 ? "" : "  DIFFERENT FROM SCALAR");
+	}
+	printf("chosen: %s\n", chooseResultKernel()->name);
+	free(scalar);
+	free(summary);
+	free(turnAroundTime);
+	free(waitTime);
+	free(burstTime);
+}
+
+/*
+ * @brief - benchmarkDump - times writing the results of DUMP_COUNT processes as text and as a binary results file
+ *
+ * The text is one fprintf line per process, the same as -r writes. The binary file is then mapped with mapResults,
+ * summarised and compared with the processes column by column.
+ */
+void benchmarkDump(void)
+{
+	struct_process_info *processes;
+	struct_results_file results;
+	struct_result_summary summary;
+	struct_sim_config config;
+	struct timespec start;
+	struct stat fileInfo;
+	double textSeconds, binarySeconds, mapSeconds;
+	off_t textBytes;
+	FILE *f;
+	int index, same = 1;
+
+	processes = (struct_process_info*) malloc(sizeof (struct_process_info) * DUMP_COUNT);
+	if (processes == NULL)
+	{
+		perror("malloc");
+		return;
+	}
+	generateWorkload(processes, DUMP_COUNT, BURST_EXPONENTIAL, 12345);
+	sortByArrivalTimes(processes, DUMP_COUNT);
+	memset(&config, 0, sizeof config);
+	config.timeQuantum = SCHEDULE_QUANTUM;
+	scheduleRoundRobin(processes, DUMP_COUNT, &config);
+
+	clock_gettime(CLOCK_MONOTONIC, &start);
+	if ((f = fopen(DUMP_PATH, "w")) == NULL)
+	{
+		perror(DUMP_PATH);
+		free(processes);
+		return;
+	}
+	for (index = 0; index < DUMP_COUNT; index++)
+		fprintf(f, "Process[%d] Arrive Time: %d, Burst Time: %d, Wait Time: %d, Turnaround Time: %d\n",
+		        processes[index].processId, processes[index].arriveTime, processes[index].burstTime,
+		        processes[index].waitTime, processes[index].turnAroundTime);
+	fclose(f);
+	textSeconds = secondsSince(&start);
+	stat(DUMP_PATH, &fileInfo);
+	textBytes = fileInfo.st_size;
+	unlink(DUMP_PATH); //so that the binary write does not also pay for truncating the text
+
+	clock_gettime(CLOCK_MONOTONIC, &start);
+	if (saveResultsBinary(DUMP_PATH, processes, DUMP_COUNT) != 0)
+	{
+		free(processes);
+		return;
+	}
+	binarySeconds = secondsSince(&start);
+	stat(DUMP_PATH, &fileInfo);
+
+	clock_gettime(CLOCK_MONOTONIC, &start);
+	if (mapResults(DUMP_PATH, &results) != 0)
+	{
+		free(processes);
+		return;
+	}
+	summariseResults(results.column[RESULT_BURST_TIME], results.column[RESULT_WAIT_TIME],
+	                 results.column[RESULT_TURNAROUND_TIME], results.count, &summary);
+	mapSeconds = secondsSince(&start);
+	same = results.count == DUMP_COUNT && summary.badWaitTimes == 0 && summary.badTurnAroundTimes == 0;
+	for (index = 0; index < DUMP_COUNT && same; index++)
+		same = results.column[RESULT_PROCESS_ID][index] == processes[index].processId &&
+		       results.column[RESULT_ARRIVE_TIME][index] == processes[index].arriveTime &&
+		       results.column[RESULT_BURST_TIME][index] == processes[index].burstTime &&
+		       results.column[RESULT_WAIT_TIME][index] == processes[index].waitTime &&
+		       results.column[RESULT_TURNAROUND_TIME][index] == processes[index].turnAroundTime &&
+		       results.column[RESULT_COMPLETION_TIME][index] == processes[index].arriveTime + processes[index].turnAroundTime;
+	unmapResults(&results);
+	unlink(DUMP_PATH);
+
+	printf("%10s %8s %12s %12s\n", "processes", "format", "seconds", "MB");
+	printf("%10d %8s %12.6f %12.1f\n", DUMP_COUNT, "text", textSeconds, textBytes / 1e6);
+	printf("%10d %8s %12.6f %12.1f\n", DUMP_COUNT, "binary", binarySeconds, fileInfo.st_size / 1e6);
+	printf("%10d %8s %12.6f %12s%s\n", DUMP_COUNT, "map+sum", mapSeconds, "", same ? "" : "  DIFFERENT RESULTS");
+	free(processes);
+}
+
+/*
+ * @brief - benchmarkSchedules - times every policy on generated workloads of 1e3 to 1e6 processes and prints JSON
+ *
+ * Every run gets its own copy of the same sorted workload. The time is measured without a trace function, then the
+ * run is repeated with one that counts the dispatches, which is the number of context switches. A tick is one time
+ * unit between the first arrival and the last completion. The peak memory is the most the benchmark has used so far,
+ * so it only grows from one run to the next.
+ */
+void benchmarkSchedules(unsigned int seed)
+{
+	const char *burstNames[] = {"exponential", "bimodal", "pareto"};
+	struct_process_info *workload, *processes;
+	struct_sim_stats *stats;
+	struct_sim_config config;
+	const struct_policy *policy;
+	struct timespec start;
+	double seconds;
+	long long ticks, contextSwitches;
+	int arraySize, bursts, first = 1;
+
+	stats = (struct_sim_stats*) malloc(sizeof (struct_sim_stats));
+	if (stats == NULL)
+	{
+		perror("malloc");
+		return;
+	}
+	printf("{\"benchmark\": \"schedule\", \"seed\": %u, \"quantum\": %d, \"runs\": [\n", seed, SCHEDULE_QUANTUM);
+	for (arraySize = 1000; arraySize <= 1000000; arraySize *= 10)
+	{
+		workload = (struct_process_info*) malloc(sizeof (struct_process_info) * arraySize);
+		processes = (struct_process_info*) malloc(sizeof (struct_process_info) * arraySize);
+		if (workload == NULL || processes == NULL)
+		{
+			perror("malloc");
+			return;
+		}
+		for (bursts = BURST_EXPONENTIAL; bursts <= BURST_PARETO; bursts++)
+		{
+			generateWorkload(workload, arraySize, bursts, seed);
+			sortByArrivalTimes(workload, arraySize);
+			for (policy = policies; policy->name != NULL; policy++)
+			{
+				if (policy->run == scheduleRoundRobinTicks && arraySize > TICK_LOOP_LIMIT)
+					continue;
+				memset(&config, 0, sizeof config);
+				config.timeQuantum = SCHEDULE_QUANTUM;
+				config.stats = stats;
+
+				memcpy(processes, workload, sizeof (struct_process_info) * arraySize);
+				initialiseStats(stats);
+				clock_gettime(CLOCK_MONOTONIC, &start);
+				policy->run(processes, arraySize, &config);
+				seconds = secondsSince(&start);
+				ticks = (long long) stats->lastCompletion - stats->firstArrival;
+
+				contextSwitches = 0;
+				memcpy(processes, workload, sizeof (struct_process_info) * arraySize);
+				config.stats = NULL;
+				config.trace = countDispatch;
+				config.traceContext = &contextSwitches;
+				policy->run(processes, arraySize, &config);
+
+				printf("%s  {\"policy\": \"%s\", \"arrivals\": \"poisson\", \"bursts\": \"%s\", \"processes\": %d, "
+				       "\"seconds\": %.6f, \"ticks\": %lld, \"contextSwitches\": %lld, \"nsPerTick\": %.3f, "
+				       "\"nsPerContextSwitch\": %.3f, \"peakRssKB\": %ld}", first ? "" : ",\n", policy->name, burstNames[bursts],
+				       arraySize, seconds, ticks, contextSwitches, ticks > 0 ? seconds * 1e9 / ticks : 0.0,
+				       contextSwitches > 0 ? seconds * 1e9 / contextSwitches : 0.0, peakMemoryKB());
+				fflush(stdout);
+				first = 0;
+			}
+		}
+		free(processes);
+		free(workload);
+	}
+	printf("\n]}\n");
+	free(stats);
+}
+
+/*
+ * @brief - countDispatch - trace function that counts the dispatches into the long long given as the context
+ */
+void countDispatch(void *context, int event, int timeCounter, const struct_process_info *process)
+{
+	(void) timeCounter;
+	(void) process;
+	if (event == TRACE_DISPATCH)
+		(*(long long*) context)++;
+}
+
+/*
+ * @brief - generateWorkload - fills an array with processes that arrive as a Poisson process and have random bursts
+ *
+ * Inputs: *processes - the array to fill
+ 			arraySize - size of the array
+ 			bursts - BURST_EXPONENTIAL, BURST_BIMODAL or BURST_PARETO
+ 			seed - the same seed always generates the same processes
+ *
+ * The time between arrivals is exponential, with a mean that keeps the CPU busy SCHEDULE_LOAD of the time for the
+ * mean burst time of the distribution. Bimodal bursts are 1 to 4 nine times in ten and 40 to 60 otherwise. Pareto bursts
+ * have a shape of 1.5 and a minimum of 4, which gives a mean near BURST_MEAN with a tail that is much longer.
+ */
+void generateWorkload(struct_process_info *processes, int arraySize, int bursts, unsigned int seed)
+{
+	const double meanBursts[] = {BURST_MEAN, 0.9 * 2.5 + 0.1 * 50, 12};
+	double meanGap = meanBursts[bursts] / SCHEDULE_LOAD;
+	double arriveTime = 0, burstTime;
+	int index;
+
+	for (index = 0; index < arraySize; index++)
+	{
+		arriveTime += -meanGap * log(nextUniform(&seed));
+		if (bursts == BURST_EXPONENTIAL)
+			burstTime = ceil(-BURST_MEAN * log(nextUniform(&seed)));
+		else if (bursts == BURST_BIMODAL)
+			burstTime = nextUniform(&seed) < 0.9 ? 1 + nextRandom(&seed) % 4 : 40 + nextRandom(&seed) % 21;
+		else
+			burstTime = ceil(4 / pow(nextUniform(&seed), 1 / 1.5));
+		processes[index].processId = index + 1;
+		processes[index].arriveTime = (int) arriveTime;
+		processes[index].burstTime = burstTime < BURST_MAX ? (int) burstTime : BURST_MAX;
+		processes[index].remainingTime = processes[index].burstTime;
+		processes[index].waitTime = 0;
+		processes[index].turnAroundTime = 0;
+		processes[index].priority = nextRandom(&seed) % 8; //for the priority policy
+	}
+}
+
+/*
+ * @brief - generateProcesses - fills an array with processes that have random arrive times and burst times
+ *
+ * Inputs: *processes - the array to fill
+ 			arraySize - size of the array
+ 			maxArriveTime - arrive times are between 0 and maxArriveTime - 1
+ 			seed - the same seed always generates the same processes
+ */
+void generateProcesses(struct_process_info *processes, int arraySize, int maxArriveTime, unsigned int seed)
+{
+	int index;
+	for (index = 0; index < arraySize; index++)
+	{
+		processes[index].processId = index + 1;
+		processes[index].arriveTime = nextRandom(&seed) % maxArriveTime;
+		processes[index].burstTime = 1 + nextRandom(&seed) % 20;
+		processes[index].remainingTime = processes[index].burstTime;
+		processes[index].waitTime = 0;
+		processes[index].turnAroundTime = 0;
+		processes[index].priority = 0;
+	}
+}
+
+/*
+ * @brief - nextRandom - xorshift random number generator, so that every run generates the same processes
+ */
+unsigned int nextRandom(unsigned int *state)
+{
+	unsigned int x = *state;
+	x ^= x << 13;
+	x ^= x >> 17;
+	x ^= x << 5;
+	return *state = x;
+}
+
+/*
+ * @brief - nextUniform - random number greater than 0 and less than 1
+ */
+double nextUniform(unsigned int *state)
+{
+	return (nextRandom(state) + 0.5) / 4294967296.0;
+}
+
+/*
+ * @brief - peakMemoryKB - the most memory the benchmark has had in RAM at once, in kilobytes
+ */
+long peakMemoryKB(void)
+{
+	struct rusage usage;
+	if (getrusage(RUSAGE_SELF, &usage) != 0)
+		return -1;
+	return usage.ru_maxrss;
+}
+
+double secondsSince(struct timespec *start)
+{
+	struct timespec now;
+	clock_gettime(CLOCK_MONOTONIC, &now);
+	return (now.tv_sec - start->tv_sec) + (now.tv_nsec - start->tv_nsec) / 1e9;
+}
@@ -0,0 +1,60 @@
+/*! @file
+ *
+ *  @brief This is a reporting program that writes the results of Prg_1 into a file from a separate process.
+ *
+ *  Prg_1 run with -x export writes its results into a ring in POSIX shared memory instead of starting its own
+ *  writing thread. This program attaches to that ring, removes its name so nothing is left behind, and writes every
+ *  frame into the output file in the same way as thread 2 of Prg_1. It can be started before or after Prg_1.
+ *
+ *  To compile this file - write in the terminal : gcc -DPRG_1_NO_MAIN -o Prg_1_report Prg_1_report.c Prg_1.c -lpthread -lrt -lm
+ *  then write in the terminal: ./Prg_1 -x export 4 /results & ./Prg_1_report /results output.txt
+ *
+ *  Whether every dispatch, preemption and completion is written, and the results of every process, follows the -g and
+ *  -r that Prg_1 was run with, which it keeps in the ring.
+ *
+ */
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <unistd.h>
+#include <stdint.h>
+#include <stdatomic.h>
+#include <sys/types.h>
+#include <sys/mman.h>
+#include <pthread.h>
+#include <semaphore.h>
+#include "Prg_1.h"
+
+int main(int argc, char* argv[])
+{
+	FILE *fp;
+	struct_ring *ring;
+	struct_options options = {NULL};
+	int n;
+
+	if (argc != 3)
+	{
+		printf("usage: ./Prg_1_report /name output.txt\n");
+		return -1;
+	}
+
+	if ((ring = AttachSharedRing(argv[1])) == NULL) //waits for Prg_1 to create the ring
+		return -1;
+	shm_unlink(argv[1]); //the mapping stays until both processes have finished with it
+	options.traceSchedule = (ring->flags & RING_TRACE_SCHEDULE) != 0; //write what Prg_1 was asked to write
+	options.processResults = (ring->flags & RING_PROCESS_RESULTS) != 0;
+	if ((fp = fopen(argv[2], "w")) == NULL)
+	{
+		perror("Error opening file");
+		DetachSharedRing(ring);
+		return -1;
+	}
+
+	n = readFrames(-1, ring, fp, &options); //write every frame into the file until Prg_1 closes the ring
+	if (n == 0)
+		printf("Ring is empty.\n");
+	fclose(fp);
+	DetachSharedRing(ring);
+	return 0;
+}
@@ -0,0 +1,76 @@
+/*! @file
+ *
+ *  @brief This is a reader for the binary results files that Prg_1 writes with -o.
+ *
+ *  The file is memory-mapped with mapResults and its columns are used in place, so only the pages of the columns that
+ *  are read are loaded from the disk. It prints a summary of the results, found with summariseResults in one pass
+ *  over the burst, wait and turnaround columns, and can also print the results of some of the processes as text.
+ *
+ *  To compile this file - write in the terminal : gcc -O2 -DPRG_1_NO_MAIN -o Prg_1_results Prg_1_results.c Prg_1.c -lpthread -lrt -lm
+ *  then write in the terminal: ./Prg_1 -i workload.txt -o results.bin 4 output.txt ; ./Prg_1_results results.bin
+ *
+ *  Options (placed before the file):
+ *    -l first[:count]  also print count processes (10 by default) from position first, counting from 0
+ *
+ */
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <unistd.h>
+#include <stdint.h>
+#include <stdatomic.h>
+#include <sys/types.h>
+#include <pthread.h>
+#include <semaphore.h>
+#include "Prg_1.h"
+
+int main(int argc, char* argv[])
+{
+	struct_results_file results;
+	struct_result_summary summary;
+	char text[MSGLENGTH];
+	long long first = -1, count = 10, index, last;
+	int opt;
+
+	while ((opt = getopt(argc, argv, "l:")) != -1)
+	{
+		switch (opt)
+		{
+		case 'l':
+			if (sscanf(optarg, "%lld:%lld", &first, &count) < 1 || first < 0 || count < 0)
+			{
+				printf("-l takes the position of the first process and an optional count: -l 0:10\n");
+				return -1;
+			}
+			break;
+		default:
+			printf("usage: ./Prg_1_results [-l first[:count]] results.bin\n");
+			return -1;
+		}
+	}
+	if (argc - optind != 1)
+	{
+		printf("usage: ./Prg_1_results [-l first[:count]] results.bin\n");
+		return -1;
+	}
+
+	if (mapResults(argv[optind], &results) != 0)
+		return -1;
+	summariseResults(results.column[RESULT_BURST_TIME], results.column[RESULT_WAIT_TIME],
+	                 results.column[RESULT_TURNAROUND_TIME], results.count, &summary);
+	resultSummaryText(text, sizeof text, &summary);
+	printf("%s", text);
+
+	if (first >= 0 && (uint64_t) first < results.count)
+	{
+		last = (uint64_t) count < results.count - first ? first + count : (long long) results.count; //first + count may overflow
+		for (index = first; index < last; index++)
+			printf("Process[%d] Arrive Time: %d, Burst Time: %d, Wait Time: %d, Turnaround Time: %d, Completion Time: %d\n",
+			       results.column[RESULT_PROCESS_ID][index], results.column[RESULT_ARRIVE_TIME][index],
+			       results.column[RESULT_BURST_TIME][index], results.column[RESULT_WAIT_TIME][index],
+			       results.column[RESULT_TURNAROUND_TIME][index], results.column[RESULT_COMPLETION_TIME][index]);
+	}
+	unmapResults(&results);
+	return 0;
+}
@@ -3,6 +3,23 @@
  *  @brief This is a page replacement program for virtual memory mangement using FIFO algorithm.
  *
  *  This contains the structure and "methods" for operating a page replacement program for virtual memory mangement using FIFO algorithm.
+ *  With -p it instead runs other page replacement policies over the same reference string and compares their faults,
+ *  hit ratios and evictions: fifo, lru, clock, second-chance, lfu, arc and opt, or all of them with -p all.
+ *
+ *  The reference string is built in, or read from a trace of any length with -f file (-f - for stdin), a chunk at a
+ *  time. A text trace holds page numbers; a binary one (-b 32 or -b 64) holds addresses, divided by the page size
+ *  given with -s (4096 by default) to give page numbers. -s also turns the numbers of a text trace into addresses.
+ *    e.g. ./Prg_2 -p all -f trace.txt 64      or      cat trace.bin | ./Prg_2 -p lru,arc -b 64 -s 4096 -f - 1024
+ *
+ *  With -c the number of frames is the largest of a curve: the faults of each policy (lru and fifo unless -p is given)
+ *  are found for every number of frames from 1 up to it in one pass over the trace, and those where FIFO, or another
+ *  policy that is not a stack algorithm, has more faults than with one frame fewer (Belady's anomaly) are marked.
+ *
+ *  With -w workers a batch of runs is shared out between that many worker threads, or one for each processor with
+ *  -w 0: each policy (fifo unless -p is given) is run with each number of frames in a list such as 4,8,16-32, every
+ *  worker reading the one memory-mapped trace with a cursor of its own, and the results are printed in one table.
+ *  With -c the workers instead share out the runs of the curve of each policy but lru.
+ *    e.g. ./Prg_2 -w 8 -p all -f trace.txt 1-32      or      ./Prg_2 -c -w 8 -f trace.txt 2000
  *
  *  To use this program, make sure you have src.txt and data.txt in your folder
  *  To compile this file - write in the terminal : gcc -o Prg_2 Prg_2.c -lpthread -lrt
@@ -22,44 +39,307 @@
 #include <pthread.h>
 #include <semaphore.h>
 #include <errno.h>
+#include <fcntl.h>
+#include <limits.h>
+#include <stdint.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <sys/types.h>
 
 /* *************************************************************************** */
-#define REFERENCESTRINGSIZE 24
-const char *REFERENCE_STRING = "7 0 1 2 0 3 0 4 2 3 0 3 0 3 2 1 2 0 1 7 0 1 7 5";
+const char *REFERENCE_STRING = "7 0 1 2 0 3 0 4 2 3 0 3 0 3 2 1 2 0 1 7 0 1 7 5"; //the reference string used when no trace file is given
+/* *************************************************************************** */
+#define PRINT_FRAME_LIMIT 32 //the frames are printed after every reference only up to this many frames
+#define PRINT_REFERENCE_LIMIT 1000 //and this many references
+/* *************************************************************************** */
+#define TRACE_CHUNK 65536 //references read from the trace and given to the policies at a time
+#define TRACE_BUFFER_BYTES (1 << 20) //bytes read at a time from a trace that cannot be memory-mapped, such as stdin
+#define TRACE_TOKEN_BYTES 64 //longest number allowed in a text trace
+#define TRACE_RELEASE_BYTES (64 << 20) //the part of a mapped trace that has been read is given back in steps of this many bytes
+
+/* formats of a trace file - the value of each is the size of an address in the binary formats */
+#define TRACE_TEXT 0 //page numbers, or addresses with -s, written in decimal or 0x hexadecimal and separated by white space
+#define TRACE_BINARY32 4 //32-bit addresses in the byte order of the machine
+#define TRACE_BINARY64 8 //64-bit addresses in the byte order of the machine
+#define TRACE_DEFAULT_PAGE_SIZE 4096 //page size of a binary trace when -s is not given
 /* *************************************************************************** */
 struct LinkedList
 {
-	char data;
+	int data; //page number held in the frame, -1 when the frame is empty
 	struct LinkedList *next;
 };
 
 typedef struct LinkedList *node;
 
+/* a reference trace, read a chunk at a time so a trace of any length can be used without holding it in memory */
+typedef struct {
+	int fd; //-1 for the built-in reference string
+	int format; //TRACE_TEXT, TRACE_BINARY32 or TRACE_BINARY64
+	unsigned long long pageSize; //an address is divided by this to give its page number
+	const char *data; //the part of the trace that has been read into the buffer, or the whole trace when it is mapped
+	size_t length; //number of bytes in data
+	size_t offset; //position in data of the next byte to parse
+	char *buffer; //TRACE_BUFFER_BYTES read from a file that cannot be mapped, NULL when data is mapped or built in
+	size_t mapped; //length of the mapping, 0 when data is not mapped
+	size_t released; //bytes at the start of the mapping that have been given back
+	int end; //1 once the last byte of a file that is read has been read
+	int failed; //1 once reading the file failed
+	long long references; //number of references read so far
+	int shared; //1 for a cursor made by TraceShare, which reads the mapping of another reader and does not own it
+} struct_trace_reader;
+
+/* index from a page number to the frame holding it, so that finding a page does not walk the frames.
+ * Pages numbered from 0 up to PAGE_INDEX_DIRECT_PAGES, or up to PAGE_INDEX_DENSITY times the number of frames, are
+ * looked up in an array with an entry per page, and other page numbers in an open-addressing hash table that grows
+ * when it is half full. The array is sized from the first chunk of the trace, and later pages beyond it go to the hash
+ * table. The value kept for a page is a frame number, or for the replacement policies any number >= 0 */
+#define PAGE_INDEX_DIRECT_PAGES (1 << 20)
+#define PAGE_INDEX_DENSITY 16
+
+typedef struct {
+	int *direct; //frame of every page number below directSize, -1 if the page is not in a frame
+	int directSize; //number of entries in direct, 0 when every page is in the hash table
+	int *keys; //hash table - page number in each slot, apart from the frames so a miss only reads the keys
+	int *frames; //hash table - frame of each slot, -1 for an empty slot
+	unsigned int mask; //hash table - number of slots - 1, a power of two at least twice the number of pages held
+	int shift; //hash table - 32 - log2 of the number of slots
+	int used; //hash table - number of pages held
+} struct_page_index;
+
+/* doubly-linked list of the entries of a page replacement policy, threaded through the arrays of a struct_entries */
+typedef struct {
+	int head; //most recently added entry, -1 when the list is empty
+	int tail; //least recently added entry, -1 when the list is empty
+	int size;
+} struct_entry_list;
+
+/* the entries of a page replacement policy - one per frame, or per frame and remembered page for ARC */
+typedef struct {
+	int *page; //page held by each entry
+	int *prev; //entry nearer the head of the list the entry is in, -1 at the head
+	int *next; //entry nearer the tail, -1 at the tail
+	int *mark; //what the policy keeps about each entry - a reference bit, or the list the entry is in
+} struct_entries;
+
+/* binary heap of entries with the smallest key at the top, that knows where each entry is so its key can change */
+typedef struct {
+	int *heap; //entries in heap order
+	int *position; //position of each entry in heap
+	long long *key; //key of each entry
+	long long *tie; //order of entries with the same key, the smallest first
+	int size;
+} struct_entry_heap;
+
+/* the results of running a page replacement policy over a reference string */
+typedef struct {
+	long long references;
+	long long faults;
+	long long evictions; //faults that replaced a page, rather than filling an empty frame
+} struct_replacement_stats;
+
+/* a page replacement policy being run over a reference string a chunk at a time - each policy uses some of the fields */
+typedef struct {
+	int frameSize;
+	struct_page_index index; //frame, or entry, of each page
+	struct_entries entries; //lru, second-chance and arc
+	struct_entry_list lists[4]; //lru and second-chance use the first, arc one for each ARC_ list
+	struct_entry_heap heap; //lfu and opt
+	int *pages; //page held in each frame - fifo, clock, lfu and opt
+	char *referenced; //reference bit of each frame - clock
+	int used; //number of frames, or entries, that have been used
+	int hand; //oldest frame for fifo, the hand for clock
+	int target; //size T1 is aimed at - arc
+	long long position; //position in the reference string of the next reference
+	int *trace; //every reference so far - opt, which needs to know the future
+	long long traceCapacity;
+	const int *nextUse; //opt - position of the next reference to the page of each reference of the whole trace, found
+	                    //once for a batch and shared by its runs, NULL for the run to keep the trace itself
+
+	struct_replacement_stats stats;
+} struct_replacement_run;
+
+/* a page replacement policy - start() allocates what it needs in a run, reference() replaces pages for the next
+ * count references, and finish(), if there is one, is called after the last reference. Each returns 0, or -1 if
+ * there is not enough memory */
+typedef struct {
+	const char *name;
+	int (*start)(struct_replacement_run *run);
+	int (*reference)(struct_replacement_run *run, const int *arr, int count);
+	int (*finish)(struct_replacement_run *run);
+	const char *description;
+} struct_replacement_policy;
+
+#define REPLACEMENT_POLICY_LIMIT 16 //most policies that can be compared in one run
+
+/* lists of the adaptive replacement cache - the pages in the frames seen once and more than once recently, then
+ * the pages replaced from each of them that are still remembered */
+#define ARC_T1 0
+#define ARC_T2 1
+#define ARC_B1 2
+#define ARC_B2 3
+
+/* fault counts of policies for every number of frames from 1 to frames, found with -c */
+typedef struct {
+	int frames; //largest number of frames
+	int numOfPolicies;
+	const struct_replacement_policy **policies;
+	long long references;
+	long long *faults; //faults of policy p with f frames at faults[p * frames + f - 1]
+	int workers; //with -w, the runs of the policies other than lru are shared out between this many worker threads
+} struct_fault_curve;
+
+/* LRU stack distances of the references of a trace - the stack distance of a reference is the number of different
+ * pages referenced since the last reference to the same page, counting itself, and LRU with that many frames or more
+ * finds the page in a frame. The times of the last reference to each page are marked in a Fenwick tree, so the
+ * pages referenced since a time are counted in time in proportion to the log of the number of times */
+#define STACK_TIMES_START (2 * TRACE_CHUNK) //number of times the tree covers at first
+
+typedef struct {
+	struct_page_index lastTime; //time of the last reference to each page
+	int *tree; //Fenwick tree over the times, 1 at the time of the last reference to each page - tree[0] is not used
+	int *timePage; //page referenced at each time, -1 once the page has been referenced again
+	int capacity; //number of times covered - when they are used up the times in use are numbered again from 0
+	int now; //time of the next reference
+	int pages; //number of different pages referenced so far, which is the number of times marked in the tree
+	int frames; //largest stack distance counted on its own
+	long long *distances; //number of references at each stack distance 1 to frames, [frames + 1] for any larger one
+	long long firstReferences; //references to pages that had not been referenced before, a fault for any number of frames
+} struct_stack_distance;
+
+/* a batch of runs shared out between worker threads with -w - every policy with every number of frames, in the order
+ * they are printed */
+#define BATCH_FRAME_SIZE_LIMIT 65536 //most numbers of frames in a batch
+#define BATCH_WORKER_LIMIT 1024 //most worker threads
+
+typedef struct {
+	struct_trace_reader *trace; //the mapped trace, read by each worker with a cursor of its own made by TraceShare
+	int workers;
+	int numOfRuns;
+	const struct_replacement_policy **policies; //policy of each run
+	int *frameSizes; //number of frames of each run
+	struct_replacement_stats *results; //results of each run
+	int hashOnly; //1 to give each run only the hash table of a page index, for the many runs of -c
+	int *nextUse; //the next uses of the trace shared by the opt runs, found by runBatch
+	long long references;
+} struct_batch;
+
+/* a worker thread of a batch, which runs every workers-th run of it from the run numbered worker */
+typedef struct {
+	struct_batch *batch;
+	int worker;
+	int result; //0 once the runs are done, -1 if they could not be
+	long long references;
+} struct_batch_worker;
+
 typedef struct {
 	sem_t *sem_pageReplacement;
 	sem_t *sem_signalHandler;
-	int *count;
-	int *arr;
+	long long *count;
+	int *arr; //TRACE_CHUNK references read from the trace at a time
 	int frameSize;
-	int *faults;
+	long long *faults;
+	struct_trace_reader *trace;
+	const struct_replacement_policy **policies; //policies to compare, chosen with -p - FIFO is printed frame by frame when there are none
+	int numOfPolicies;
+	struct_replacement_stats *results; //results of each policy
+	struct_fault_curve *curve; //filled in for every number of frames with -c instead of the results, NULL without -c
+	struct_batch *batch; //run on worker threads with -w instead, NULL without -w
 } struct_thread1_info;
 
 
 typedef struct {
 	sem_t *sem_signalHandler;
 	sem_t *sem_pageReplacement;
-	int *faults;
+	long long *faults;
+	const struct_replacement_policy **policies;
+	int numOfPolicies;
+	struct_replacement_stats *results;
+	struct_fault_curve *curve;
+	struct_batch *batch;
 } struct_thread2_info;
 
 //thread 1 functions and methods
 void createFrameList(int frameSize);
+int PageIndexInit(struct_page_index *index, int frameSize, const int *arr, int count);
+void PageIndexFree(struct_page_index *index);
+int PageIndexFind(const struct_page_index *index, int page);
+int PageIndexInsert(struct_page_index *index, int page, int frame);
+int PageIndexGrow(struct_page_index *index);
+void PageIndexRemove(struct_page_index *index, int page);
+unsigned int PageIndexSlot(const struct_page_index *index, int page);
 void signal_handler(int sig);
 int frameSearch(int number);
-void fifo(int count, int *arr, int *faults);
-node nodeCreate(void);
+void printFifoHeader(int print);
+void fifo(int count, int *arr, long long *faults, int print);
 void printFrame(int arrElement);
 
-void readRefString(int *count, int *arr);
+//page replacement policies
+const struct_replacement_policy *findReplacementPolicy(const char *name);
+int parseReplacementPolicies(char *names, const struct_replacement_policy **policies);
+int ReplacementRunInit(struct_replacement_run *run, const struct_replacement_policy *policy, int frameSize,
+                       const int *arr, int count);
+void ReplacementRunFree(struct_replacement_run *run);
+int compareReplacementPolicies(struct_trace_reader *trace, int *arr, int frameSize,
+                               const struct_replacement_policy **policies, int numOfPolicies,
+                               struct_replacement_stats *results);
+int runReplacementPolicies(struct_trace_reader *trace, int *arr, const struct_replacement_policy **policies,
+                           const int *frameSizes, int numOfRuns, int hashOnly, const int *nextUse,
+                           struct_replacement_stats *results);
+void printReplacementResults(const struct_replacement_policy **policies, const struct_replacement_stats *results,
+                             int numOfPolicies);
+int startFrames(struct_replacement_run *run);
+int startEntries(struct_replacement_run *run);
+int startClock(struct_replacement_run *run);
+int startArc(struct_replacement_run *run);
+int startHeap(struct_replacement_run *run);
+int referenceFifo(struct_replacement_run *run, const int *arr, int count);
+int referenceLru(struct_replacement_run *run, const int *arr, int count);
+int referenceClock(struct_replacement_run *run, const int *arr, int count);
+int referenceSecondChance(struct_replacement_run *run, const int *arr, int count);
+int referenceLfu(struct_replacement_run *run, const int *arr, int count);
+int referenceArc(struct_replacement_run *run, const int *arr, int count);
+void arcReplace(struct_replacement_run *run, int inB2);
+int referenceOptimal(struct_replacement_run *run, const int *arr, int count);
+int finishOptimal(struct_replacement_run *run);
+int optimalReplace(struct_replacement_run *run, const int *arr, const int *nextUse, int count);
+int EntriesInit(struct_entries *entries, int size);
+void EntriesFree(struct_entries *entries);
+void EntryListPush(struct_entry_list *list, struct_entries *entries, int entry);
+void EntryListRemove(struct_entry_list *list, struct_entries *entries, int entry);
+int EntryHeapInit(struct_entry_heap *heap, int size);
+void EntryHeapFree(struct_entry_heap *heap);
+void EntryHeapPush(struct_entry_heap *heap, int entry, long long key, long long tie);
+void EntryHeapUpdate(struct_entry_heap *heap, int entry, long long key, long long tie);
+void EntryHeapMove(struct_entry_heap *heap, int entry, int position);
+int EntryHeapCompare(const struct_entry_heap *heap, int entry, long long key, long long tie);
+
+//reading the reference string
+int TraceOpen(struct_trace_reader *trace, const char *path, int format, unsigned long long pageSize);
+int TraceRead(struct_trace_reader *trace, int *pages, int max);
+int TraceNext(struct_trace_reader *trace, unsigned long long *value);
+size_t TraceAvailable(struct_trace_reader *trace, size_t need);
+void TraceRelease(struct_trace_reader *trace);
+void TraceShare(const struct_trace_reader *trace, struct_trace_reader *cursor);
+void TraceClose(struct_trace_reader *trace);
+//fault curves
+int computeFaultCurve(struct_trace_reader *trace, int *arr, struct_fault_curve *curve);
+void printFaultCurve(const struct_fault_curve *curve);
+int countTracePages(const struct_trace_reader *trace, int *arr);
+int faultCurveBatch(struct_trace_reader *trace, struct_fault_curve *curve, int simulated);
+int StackDistanceInit(struct_stack_distance *stack, int frames, const int *arr, int count);
+void StackDistanceFree(struct_stack_distance *stack);
+int stackDistanceReference(struct_stack_distance *stack, const int *arr, int count);
+int StackDistanceRenumber(struct_stack_distance *stack);
+void stackDistanceFaults(const struct_stack_distance *stack, long long *faults);
+void FenwickAdd(int *tree, int capacity, int time, int value);
+int FenwickSum(const int *tree, int time);
+//batches of runs on worker threads
+int parseFrameSizes(const char *text, int **frameSizes);
+int runBatch(struct_batch *batch);
+void *batchWorker(struct_batch_worker *worker);
+void printBatchResults(const struct_batch *batch);
+int *findNextUses(const struct_trace_reader *trace, int *arr);
+
 int isNumber(char number[]);
 void instructions(void);
 
@@ -73,7 +353,21 @@ int initialiseSemaphores(sem_t *sem_pageReplacement, sem_t *sem_signalHandler);
 void *thread1_routine(struct_thread1_info * data);
 void *thread2_routine(struct_thread2_info * data);
 
+const struct_replacement_policy replacementPolicies[] = {
+	{"fifo", startFrames, referenceFifo, NULL, "first in first out"},
+	{"lru", startEntries, referenceLru, NULL, "least recently used"},
+	{"clock", startClock, referenceClock, NULL, "clock, a hand over the frames that skips pages referenced since it last passed"},
+	{"second-chance", startEntries, referenceSecondChance, NULL, "FIFO that moves referenced pages to the back of the queue"},
+	{"lfu", startHeap, referenceLfu, NULL, "least frequently used since loaded, least recently used on a tie"},
+	{"arc", startArc, referenceArc, NULL, "adaptive replacement cache"},
+	{"opt", startHeap, referenceOptimal, finishOptimal, "Belady's optimal, the page used furthest in the future - keeps the trace in memory"},
+	{NULL, NULL, NULL, NULL, NULL}
+};
+
 node start;
+node fifoNext; //the next empty frame fifo fills
+node fifoOldest; //the frame fifo replaces next
+struct_page_index pageIndex; //the frame of every page in the frame list, kept up to date by fifo
 volatile sig_atomic_t flag = 0; //an integer type which can be accessed as an
 //atomic entity even in the presence of asynchronous interrupts made by signals
 //value of the variable may change at any time - without any action being
@@ -89,6 +383,8 @@ void instructions(void)
 	printf("           *********** To compile this file - write in the terminal :- ****************\n");
 	printf("           ***************** gcc -o Prg_2 Prg_2.c -lpthread -lrt **********************\n");
 	printf("           ************* then write in the terminal:  ./Prg_2 4 ***********************\n");
+	printf("           ********** or to compare the policies:  ./Prg_2 -p all 4 *******************\n");
+	printf("           ********** or on worker threads:  ./Prg_2 -w 4 -p all 1-8 ******************\n");
 	printf("           ****************************************************************************\n\n");
 
 }
@@ -99,42 +395,197 @@ void sighandler(int sig) {
 	flag = 1; // set flag so that the program knows when to stop the while loop - which wait for the ctrl+c signal
 }
 
-node nodeCreate(void)
-{
-	node newNode;
-	newNode = malloc(sizeof(node)); //allocate memory
-	newNode->data = -1;     // -1 means that the data is currently empty
-	newNode->next = NULL;    //indicates the next node as NULL as default
-	return newNode;
-}
-
 void createFrameList(int frameSize)
 {
 	int index;
-	node current, new_node;
+	start = malloc(sizeof(struct LinkedList) * frameSize); //the frames are in one block, so a frame's number is its position
+	if (start == NULL)
+	{
+		perror("malloc");
+		exit(1);
+	}
 	for (index = 0; index < frameSize; index++) //createFrame
 	{
-		new_node = nodeCreate();
-		if (start == NULL) //if start is empty then set the start as the new node and current to new node
-			start = current = new_node;
-		else
-			current = current->next = new_node; //Set the pointer after the current as the new node and set the current to that.
+		start[index].data = -1; // -1 means that the data is currently empty
+		start[index].next = &start[index + 1 < frameSize ? index + 1 : 0]; //the last frame points back to the start
 	}
-	current->next = start; //when current is at the end, point to the start. */
+	fifoNext = fifoOldest = start;
 }
 
 
 int frameSearch(int number)
 {
-	node temp_node; //check if the number is within the frame
-	temp_node = start; //starts checking from the start of the frame
-	do
+	return PageIndexFind(&pageIndex, number) >= 0; //check if the number is within the frame, without walking the frames
+}
+
+/*
+ * @brief - PageIndexInit - creates an empty index for the pages of a reference string
+ *
+ * Inputs: frameSize - the number of frames, which is the most pages the index is expected to hold at once
+ 			*arr, count - the reference string, or its first chunk, used to size the direct-mapped array
+ *
+ * Returns 0 on success or -1 if there is not enough memory.
+ */
+int PageIndexInit(struct_page_index *index, int frameSize, const int *arr, int count)
+{
+	int position, maxPage = -1;
+	unsigned int slots = 2;
+
+	memset(index, 0, sizeof (struct_page_index));
+	for (position = 0; position < count; position++)
+		if (arr[position] > maxPage)
+			maxPage = arr[position];
+	if (maxPage >= 0 && (maxPage < PAGE_INDEX_DIRECT_PAGES || maxPage / PAGE_INDEX_DENSITY < frameSize)) //dense page numbers
+	{
+		index->directSize = maxPage + 1;
+		if ((index->direct = malloc(sizeof (int) * index->directSize)) == NULL)
+			return -1;
+		memset(index->direct, 0xff, sizeof (int) * index->directSize); //every page starts with no frame, -1
+	}
+
+	index->shift = 31;
+	while (slots < 2u * (unsigned int) frameSize) //at most half full, so a probe finds an empty slot quickly
+	{
+		slots *= 2;
+		index->shift--;
+	}
+	index->mask = slots - 1;
+	index->keys = malloc(sizeof (int) * slots);
+	if ((index->frames = malloc(sizeof (int) * slots)) == NULL || index->keys == NULL)
+		return -1;
+	memset(index->frames, 0xff, sizeof (int) * slots);
+	return 0;
+}
+
+void PageIndexFree(struct_page_index *index)
+{
+	free(index->direct);
+	free(index->keys);
+	free(index->frames);
+}
+
+/*
+ * @brief - PageIndexSlot - the slot of the hash table a page is looked for first - Fibonacci hashing of the page number
+ */
+unsigned int PageIndexSlot(const struct_page_index *index, int page)
+{
+	return ((unsigned int) page * 2654435769u) >> index->shift;
+}
+
+/*
+ * @brief - PageIndexFind - the frame that holds a page, or -1 if the page is not in a frame
+ */
+int PageIndexFind(const struct_page_index *index, int page)
+{
+	unsigned int slot;
+
+	if ((unsigned int) page < (unsigned int) index->directSize)
+		return index->direct[page];
+	for (slot = PageIndexSlot(index, page); index->frames[slot] >= 0; slot = (slot + 1) & index->mask)
+		if (index->keys[slot] == page)
+			return index->frames[slot];
+	return -1;
+}
+
+/*
+ * @brief - PageIndexInsert - records that a page is held in a frame, replacing the frame recorded for it before
+ *
+ * Returns 0 on success or -1 if the hash table had to grow and there is not enough memory.
+ */
+int PageIndexInsert(struct_page_index *index, int page, int frame)
+{
+	unsigned int slot;
+
+	if ((unsigned int) page < (unsigned int) index->directSize)
+	{
+		index->direct[page] = frame;
+		return 0;
+	}
+	for (slot = PageIndexSlot(index, page); index->frames[slot] >= 0; slot = (slot + 1) & index->mask)
+		if (index->keys[slot] == page)
+		{
+			index->frames[slot] = frame;
+			return 0;
+		}
+	if ((unsigned int) index->used + 1 > (index->mask + 1) / 2) //would be more than half full
+	{
+		if (PageIndexGrow(index) != 0)
+			return -1;
+		for (slot = PageIndexSlot(index, page); index->frames[slot] >= 0; slot = (slot + 1) & index->mask)
+			;
+	}
+	index->keys[slot] = page;
+	index->frames[slot] = frame;
+	index->used++;
+	return 0;
+}
+
+/*
+ * @brief - PageIndexGrow - doubles the number of slots of the hash table and puts every page back in it
+ */
+int PageIndexGrow(struct_page_index *index)
+{
+	int *keys = index->keys, *frames = index->frames;
+	unsigned int slots = index->mask + 1, old, slot;
+
+	index->keys = malloc(sizeof (int) * slots * 2);
+	if ((index->frames = malloc(sizeof (int) * slots * 2)) == NULL || index->keys == NULL)
+	{
+		free(index->keys);
+		free(index->frames);
+		index->keys = keys;
+		index->frames = frames;
+		return -1;
+	}
+	memset(index->frames, 0xff, sizeof (int) * slots * 2);
+	index->mask = slots * 2 - 1;
+	index->shift--;
+	for (old = 0; old < slots; old++)
+		if (frames[old] >= 0)
+		{
+			for (slot = PageIndexSlot(index, keys[old]); index->frames[slot] >= 0; slot = (slot + 1) & index->mask)
+				;
+			index->keys[slot] = keys[old];
+			index->frames[slot] = frames[old];
+		}
+	free(keys);
+	free(frames);
+	return 0;
+}
+
+/*
+ * @brief - PageIndexRemove - forgets the frame of a page that has been replaced
+ *
+ * In the hash table the entries after the removed one are moved back into the gap, instead of leaving a marker, so
+ * that a lookup still stops at the first empty slot however many pages have been replaced.
+ */
+void PageIndexRemove(struct_page_index *index, int page)
+{
+	unsigned int slot, next, home;
+
+	if ((unsigned int) page < (unsigned int) index->directSize)
+	{
+		index->direct[page] = -1;
+		return;
+	}
+	for (slot = PageIndexSlot(index, page); index->frames[slot] >= 0; slot = (slot + 1) & index->mask)
+		if (index->keys[slot] == page)
+			break;
+	if (index->frames[slot] < 0) //the page is not in the index
+		return;
+	index->frames[slot] = -1;
+	index->used--;
+	for (next = (slot + 1) & index->mask; index->frames[next] >= 0; next = (next + 1) & index->mask)
 	{
-		if (temp_node->data == number) //if the number in the parameter is the same as the number in the frame then return true
-			return (1);
-		temp_node = temp_node->next; //otherwise check the next frame
-	} while (temp_node != start); //check until the frame loops back to the start again
-	return (0);
+		home = PageIndexSlot(index, index->keys[next]);
+		if (((next - home) & index->mask) >= ((next - slot) & index->mask)) //the entry can move back to the gap
+		{
+			index->keys[slot] = index->keys[next];
+			index->frames[slot] = index->frames[next];
+			index->frames[next] = -1;
+			slot = next;
+		}
+	}
 }
 
 void printFrame(int arrElement)
@@ -153,15 +604,33 @@ void printFrame(int arrElement)
 	} while (temp != start); //run until the temp node loops and meets the start node
 }
 
-void fifo(int count, int *arr, int *faults)
+/*
+ * @brief - printFifoHeader - prints the heading of the frames printed by fifo, or says that they are not printed
+ */
+void printFifoHeader(int print)
+{
+	if (print)
+	{
+		printf("--------------------------------------");
+		printf("\n  Ref String  |    Page frames\n");
+		printf("--------------------------------------");
+	}
+	else
+		printf("Running the reference string - the frames are only printed up to %d frames and %d references\n",
+		       PRINT_FRAME_LIMIT, PRINT_REFERENCE_LIMIT);
+}
+
+/*
+ * @brief - fifo - replaces the pages in the frame list for a chunk of the reference string
+ *
+ * Each call carries on from where the last one stopped, with the frames at fifoNext still to be filled and the
+ * oldest page at fifoOldest. Prints the frames after each reference if print is 1.
+ */
+void fifo(int count, int *arr, long long *faults, int print)
 {
 	int index;
-	node temp, last, curr;
-	temp = last = curr = start;
+	node last = fifoOldest, curr = fifoNext;
 
-	printf("--------------------------------------");
-	printf("\n  Ref String  |    Page frames\n");
-	printf("--------------------------------------");
 	for (index = 0; index < count; index++) //check each number of the string
 	{
 		if (!frameSearch(arr[index])) //means that the number of the string cannot be found in the frame
@@ -170,136 +639,1989 @@ void fifo(int count, int *arr, int *faults)
 			if (curr->data == -1) //if the element in the frame is empty or NULL
 			{
 				curr->data = arr[index]; //place the number into the frame
+				PageIndexInsert(&pageIndex, arr[index], curr - start);
 				curr = curr->next; //move to the next frame that can be replaced
 			}
 			else
 			{
+				PageIndexRemove(&pageIndex, last->data); //the oldest page leaves the frames
 				last->data = arr[index]; //replace the oldest frame with a new one
+				PageIndexInsert(&pageIndex, arr[index], last - start);
 				last = last->next; //move to the new oldest frame
 			}
-			printFrame(arr[index]); //print frame contents
-			printf("    Page fault Number: %d", *faults);	//when there's a page fault, display the page fault number as well
+			if (print)
+			{
+				printFrame(arr[index]); //print frame contents
+				printf("    Page fault Number: %lld", *faults);	//when there's a page fault, display the page fault number as well
+			}
 		}
-		else
+		else if (print)
 			printFrame(arr[index]); //print frame contents
 	}
+	fifoOldest = last;
+	fifoNext = curr;
+}
+
+/* ************************ Methods and functions for comparing page replacement policies **************************** */
+
+/*
+ * @brief - findReplacementPolicy - looks up a page replacement policy by the name given with -p, NULL if there is none
+ */
+const struct_replacement_policy *findReplacementPolicy(const char *name)
+{
+	int index;
+	for (index = 0; replacementPolicies[index].name != NULL; index++)
+		if (strcmp(replacementPolicies[index].name, name) == 0)
+			return &replacementPolicies[index];
+	return NULL;
 }
 
-void readRefString(int *count, int *arr)
+/*
+ * @brief - parseReplacementPolicies - looks up the comma separated policy names given with -p, or every policy for "all"
+ *
+ * Returns the number of policies put in policies, which has room for REPLACEMENT_POLICY_LIMIT, or -1 after printing
+ * the policies there are if a name is not one of them.
+ */
+int parseReplacementPolicies(char *names, const struct_replacement_policy **policies)
 {
-	int index, number = 0, cnt = 0, refStringPos;
+	char *name, *save;
+	int count = 0, index;
 
-	for (index = 0; index  < REFERENCESTRINGSIZE; index++)
+	if (strcmp(names, "all") == 0)
 	{
-		cnt = sscanf(REFERENCE_STRING, "%d %n", &arr[index], &refStringPos); //get each number in the reference string and get the position in the string
-		if (cnt != 1) break;
-		else
-			REFERENCE_STRING += refStringPos; //the string to the new position so that the program knows where to look next loop
-		number++;
+		for (index = 0; replacementPolicies[index].name != NULL; index++)
+			policies[count++] = &replacementPolicies[index];
+		return count;
+	}
+	for (name = strtok_r(names, ",", &save); name != NULL; name = strtok_r(NULL, ",", &save))
+	{
+		if (count == REPLACEMENT_POLICY_LIMIT || (policies[count] = findReplacementPolicy(name)) == NULL)
+		{
+			printf("Unknown page replacement policy \"%s\" - -p takes up to %d of:\n", name, REPLACEMENT_POLICY_LIMIT);
+			for (index = 0; replacementPolicies[index].name != NULL; index++)
+				printf("  %-14s %s\n", replacementPolicies[index].name, replacementPolicies[index].description);
+			printf("  %-14s every policy\n", "all");
+			return -1;
+		}
+		count++;
 	}
-	*count = number; //set the count to the size of the reference string
+	return count;
 }
 
-int isNumber(char number[]) //checks if the number is a positive integer
+/*
+ * @brief - ReplacementRunInit - starts a policy with frameSize empty frames
+ *
+ * Inputs: *arr, count - the first chunk of the reference string, used to size the page index - NULL to give the run
+ 			              only the hash table, which then starts small and grows with the pages the run holds
+ *
+ * Returns 0 on success or -1 if there is not enough memory, after freeing what was allocated.
+ */
+int ReplacementRunInit(struct_replacement_run *run, const struct_replacement_policy *policy, int frameSize,
+                       const int *arr, int count)
 {
-	int numIndex = 0;
-	//checking for negative numbers
-	if (number[0] == '-')
-		return 1;
-	while (number[numIndex] != 0) //if greater or equal than one digit
+	int list;
+
+	memset(run, 0, sizeof (struct_replacement_run));
+	run->frameSize = frameSize;
+	for (list = 0; list < 4; list++)
+		run->lists[list].head = run->lists[list].tail = -1;
+	if (PageIndexInit(&run->index, arr != NULL ? frameSize : 1, arr, count) != 0 || policy->start(run) != 0)
 	{
-		if (!isdigit(number[numIndex])) //check if it is number
-			return 1; //if not return false
-		numIndex++;
+		ReplacementRunFree(run);
+		return -1;
 	}
 	return 0;
 }
 
-
-void *thread1_routine(struct_thread1_info * data)
+void ReplacementRunFree(struct_replacement_run *run)
 {
-	sem_wait(data->sem_pageReplacement); //wait for page replacement sem
+	PageIndexFree(&run->index);
+	EntriesFree(&run->entries);
+	EntryHeapFree(&run->heap);
+	free(run->pages);
+	free(run->referenced);
+	free(run->trace);
+	memset(run, 0, sizeof (struct_replacement_run));
+}
 
-	readRefString(data->count, data->arr); //read the reference string
-	createFrameList(data->frameSize); //create the frame with NULL values
-	fifo(*data->count, data->arr, data->faults); //run the FIFO
-	puts("");
+/*
+ * @brief - compareReplacementPolicies - runs every policy over a trace with frameSize frames
+ *
+ * Inputs: *arr - room for TRACE_CHUNK references
+ *
+ * The trace is read once whatever the number of policies. Returns 0 on success, or -1 if the trace is not valid or
+ * there is not enough memory for a policy, after printing why.
+ */
+int compareReplacementPolicies(struct_trace_reader *trace, int *arr, int frameSize,
+                               const struct_replacement_policy **policies, int numOfPolicies,
+                               struct_replacement_stats *results)
+{
+	int frameSizes[REPLACEMENT_POLICY_LIMIT];
+	int index;
 
-	sem_post(data->sem_signalHandler); /* relinquish access to signalhandler sem */
+	for (index = 0; index < numOfPolicies; index++)
+		frameSizes[index] = frameSize;
+	return runReplacementPolicies(trace, arr, policies, frameSizes, numOfPolicies, 0, NULL, results);
 }
 
-void *thread2_routine(struct_thread2_info * data)
+/*
+ * @brief - runReplacementPolicies - runs policies[run] with frameSizes[run] frames for each run, giving each chunk of a
+ *			trace to each run in turn
+ *
+ * Inputs: *arr - room for TRACE_CHUNK references
+ 			hashOnly - 1 to give each run only the hash table of its page index, when there are too many runs for an
+ 			           array each
+ 			*nextUse - the next uses of the whole trace for the opt runs to share, found by findNextUses, or NULL for
+ 			           each opt run to keep a copy of the trace
+ *
+ * The trace is read once whatever the number of runs. Returns 0 on success, or -1 if the trace is not valid or there
+ * is not enough memory for a run, after printing why.
+ */
+int runReplacementPolicies(struct_trace_reader *trace, int *arr, const struct_replacement_policy **policies,
+                           const int *frameSizes, int numOfRuns, int hashOnly, const int *nextUse,
+                           struct_replacement_stats *results)
 {
-	sem_wait(data->sem_signalHandler); //waits for access to signal handler
-	printf("\n\nAwaiting ctrl+c signal to print total number of page faults...\n");
+	struct_replacement_run *runs;
+	int index = 0, count, started = 0, result = 0;
 
-	//waits until ctrl+c is pressed before executing the function
-	/* ***************************************** */
-	if (signal(SIGINT, sighandler) == SIG_ERR) //waits until ctrl+c signal is received - if SIG_ERR then print error
-		printf("\n cant catch SIGINT \n");
-	sleep(1); //to put less strain on the program - sleep for one second
-	while (flag != 1);
+	if ((runs = calloc(numOfRuns, sizeof (struct_replacement_run))) == NULL)
+	{
+		perror("calloc");
+		return -1;
+	}
+	count = TraceRead(trace, arr, TRACE_CHUNK);
+	for (index = 0; index < numOfRuns && count >= 0; index++, started++)
+	{
+		if (ReplacementRunInit(&runs[index], policies[index], frameSizes[index], hashOnly ? NULL : arr,
+		                       hashOnly ? 0 : count) != 0)
+			break;
+		runs[index].nextUse = nextUse;
+	}
+	while (count > 0 && started == numOfRuns)
+	{
+		for (index = 0; index < numOfRuns; index++)
+			if (policies[index]->reference(&runs[index], arr, count) != 0)
+				break;
+		if (index < numOfRuns)
+			break;
+		count = TraceRead(trace, arr, TRACE_CHUNK);
+	}
+	if (count < 0)
+		result = -1; //TraceRead has said why
+	else if (started < numOfRuns || count > 0)
+	{
+		index = started < numOfRuns ? started : index;
+		printf("Not enough memory to run the %s policy with %d frames\n", policies[index]->name, frameSizes[index]);
+		result = -1;
+	}
+	for (index = 0; index < started; index++)
+	{
+		if (result == 0 && policies[index]->finish != NULL && policies[index]->finish(&runs[index]) != 0)
+		{
+			printf("Not enough memory to run the %s policy with %d frames\n", policies[index]->name, frameSizes[index]);
+			result = -1;
+		}
+		results[index] = runs[index].stats;
+		ReplacementRunFree(&runs[index]);
+	}
+	free(runs);
+	return result;
+}
 
-	/* ***************************************** */
-	printf("\nSignal Received \n");
-	printf("\n------------------------------------------------------------\n");
-	printf("             Total Number of Page faults: %d", *data->faults);
+void printReplacementResults(const struct_replacement_policy **policies, const struct_replacement_stats *results,
+                             int numOfPolicies)
+{
+	int index;
 	printf("\n------------------------------------------------------------\n");
-	sem_post(data->sem_pageReplacement); /* relinquish access to page replacement sem */
+	printf("  Policy            Faults    Hit Ratio      Evictions\n");
+	for (index = 0; index < numOfPolicies; index++)
+		printf("  %-14s %9lld %11.2f%% %14lld\n", policies[index]->name, results[index].faults,
+		       results[index].references > 0 ?
+		       100.0 * (results[index].references - results[index].faults) / results[index].references : 0.0,
+		       results[index].evictions);
+	printf("------------------------------------------------------------\n");
+}
 
+/*
+ * @brief - startFrames - the page held in each frame, for fifo
+ */
+int startFrames(struct_replacement_run *run)
+{
+	run->pages = malloc(sizeof (int) * run->frameSize);
+	return run->pages != NULL ? 0 : -1;
 }
 
-int initialiseSemaphores(sem_t *sem_pageReplacement, sem_t *sem_signalHandler)
+/*
+ * @brief - startEntries - an entry for each frame, for the policies that keep the frames in a list
+ */
+int startEntries(struct_replacement_run *run)
 {
-	if (sem_init(sem_pageReplacement, 0, 1) == -1 || sem_init(sem_signalHandler, 0, 0) == -1)
-	{
-		printf("sem_init failed: %s\n", strerror(errno));
-		return (-1);
-	}
-	return 0;
+	return EntriesInit(&run->entries, run->frameSize);
 }
 
-int main(int argc, char* argv [])
+/*
+ * @brief - startClock - the page and reference bit of each frame
+ */
+int startClock(struct_replacement_run *run)
 {
-	int count = 0, frameSize;
-	int faults = 0;
-	int arr[REFERENCESTRINGSIZE];
+	run->referenced = malloc(run->frameSize);
+	return run->referenced != NULL ? startFrames(run) : -1;
+}
 
-	sem_t sem_pageReplacement, sem_signalHandler; /* semaphore definitions */
-	pthread_t thread1, thread2;    /* pthread defintions */
+/*
+ * @brief - startArc - an entry for each frame and for each page ARC remembers after replacing it
+ */
+int startArc(struct_replacement_run *run)
+{
+	return EntriesInit(&run->entries, 2 * run->frameSize);
+}
 
-	instructions();
+/*
+ * @brief - startHeap - the page held in each frame and a heap of the frames
+ */
+int startHeap(struct_replacement_run *run)
+{
+	return EntryHeapInit(&run->heap, run->frameSize) == 0 ? startFrames(run) : -1;
+}
 
-	if (argc != 2)
-	{
-		printf("Incorrect number of arguments placed in command line.\n");
-		printf("Please place only one integer to the command line when executing.\n");
-		return -1;
-	}
-	if (isNumber(argv[1]) != 0)
+/*
+ * @brief - referenceFifo - first in first out - the page that has been in the frames longest is replaced
+ *
+ * The same replacements as fifo, with the frames in an array instead of the frame list and nothing printed.
+ */
+int referenceFifo(struct_replacement_run *run, const int *arr, int count)
+{
+	int position, frame;
+
+	for (position = 0; position < count; position++)
 	{
-		printf("Incorrect input, try again\n");
-		return (-1);
+		if (PageIndexFind(&run->index, arr[position]) >= 0)
+			continue;
+		run->stats.faults++;
+		if (run->used < run->frameSize)
+			frame = run->used++;
+		else
+		{
+			frame = run->hand;
+			run->hand = run->hand + 1 < run->frameSize ? run->hand + 1 : 0;
+			PageIndexRemove(&run->index, run->pages[frame]);
+			run->stats.evictions++;
+		}
+		run->pages[frame] = arr[position];
+		if (PageIndexInsert(&run->index, arr[position], frame) != 0)
+			return -1;
 	}
-	frameSize = atoi(argv[1]); //sets frame size to number given in command line
-
-
-	initialiseSemaphores(&sem_pageReplacement, &sem_signalHandler); //initailise semaphores so that they can used in the threads
+	run->stats.references += count;
+	return 0;
+}
 
-	/* put values into structs so that they can be passed to the threads */
-	struct_thread1_info a = {&sem_pageReplacement, &sem_signalHandler, &count, arr, frameSize, &faults};
-	struct_thread2_info b = {&sem_signalHandler, &sem_pageReplacement, &faults};
+/*
+ * @brief - referenceLru - least recently used - the page that has gone longest without a reference is replaced
+ *
+ * The frames are kept in a list from the most to the least recently used. A reference finds its frame through the
+ * page index and moves it to the head, and a fault replaces the tail, so each reference takes the same time however
+ * many frames there are.
+ */
+int referenceLru(struct_replacement_run *run, const int *arr, int count)
+{
+	struct_entry_list *recent = &run->lists[0];
+	int position, frame;
 
-	//creates the pthreads - if not 0 then print error and exit program
-	if (pthread_create(&thread1, NULL, (void *)thread1_routine, &a) != 0 ||
-	        pthread_create(&thread2, NULL, (void *)thread2_routine, &b) != 0)
+	for (position = 0; position < count; position++)
 	{
-		perror("pthread_create");
-		return (-1);
+		if ((frame = PageIndexFind(&run->index, arr[position])) >= 0)
+		{
+			EntryListRemove(recent, &run->entries, frame);
+			EntryListPush(recent, &run->entries, frame);
+			continue;
+		}
+		run->stats.faults++;
+		if (recent->size < run->frameSize)
+			frame = recent->size; //frames are only taken off the list to be put back, so the first size are in use
+		else
+		{
+			frame = recent->tail;
+			EntryListRemove(recent, &run->entries, frame);
+			PageIndexRemove(&run->index, run->entries.page[frame]);
+			run->stats.evictions++;
+		}
+		run->entries.page[frame] = arr[position];
+		EntryListPush(recent, &run->entries, frame);
+		if (PageIndexInsert(&run->index, arr[position], frame) != 0)
+			return -1;
 	}
+	run->stats.references += count;
+	return 0;
+}
 
-	pthread_join(thread1, NULL); /* to identify if the thread-termination was completed */
-	pthread_join(thread2, NULL); //add error checking
+/*
+ * @brief - referenceClock - the clock algorithm - a hand goes round the frames and replaces the first page that has
+ *			not been referenced since the hand last passed it
+ *
+ * A page's reference bit is clear when it is loaded and set when it is referenced again; the hand clears the bits it
+ * passes over, giving those pages a second chance.
+ */
+int referenceClock(struct_replacement_run *run, const int *arr, int count)
+{
+	int position, frame;
 
+	for (position = 0; position < count; position++)
+	{
+		if ((frame = PageIndexFind(&run->index, arr[position])) >= 0)
+		{
+			run->referenced[frame] = 1;
+			continue;
+		}
+		run->stats.faults++;
+		if (run->used < run->frameSize)
+			frame = run->used++;
+		else
+		{
+			while (run->referenced[run->hand]) //give every referenced page the hand reaches a second chance
+			{
+				run->referenced[run->hand] = 0;
+				run->hand = run->hand + 1 < run->frameSize ? run->hand + 1 : 0;
+			}
+			frame = run->hand;
+			run->hand = run->hand + 1 < run->frameSize ? run->hand + 1 : 0;
+			PageIndexRemove(&run->index, run->pages[frame]);
+			run->stats.evictions++;
+		}
+		run->pages[frame] = arr[position];
+		run->referenced[frame] = 0;
+		if (PageIndexInsert(&run->index, arr[position], frame) != 0)
+			return -1;
+	}
+	run->stats.references += count;
+	return 0;
+}
+
+/*
+ * @brief - referenceSecondChance - second chance - FIFO, except that a page referenced since it was loaded or last
+ *			given a second chance goes to the back of the queue with its reference bit cleared instead of being replaced
+ *
+ * This makes the same replacements as referenceClock, but moves the pages through a queue rather than a hand over the
+ * frames, which is how the algorithm is usually described.
+ */
+int referenceSecondChance(struct_replacement_run *run, const int *arr, int count)
+{
+	struct_entry_list *queue = &run->lists[0]; //newest page at the head, oldest at the tail
+	struct_entries *frames = &run->entries;
+	int position, frame;
+
+	for (position = 0; position < count; position++)
+	{
+		if ((frame = PageIndexFind(&run->index, arr[position])) >= 0)
+		{
+			frames->mark[frame] = 1; //set the reference bit
+			continue;
+		}
+		run->stats.faults++;
+		if (queue->size < run->frameSize)
+			frame = queue->size;
+		else
+		{
+			while (frames->mark[queue->tail]) //the oldest page was referenced - clear its bit and move it to the back
+			{
+				frame = queue->tail;
+				frames->mark[frame] = 0;
+				EntryListRemove(queue, frames, frame);
+				EntryListPush(queue, frames, frame);
+			}
+			frame = queue->tail;
+			EntryListRemove(queue, frames, frame);
+			PageIndexRemove(&run->index, frames->page[frame]);
+			run->stats.evictions++;
+		}
+		frames->page[frame] = arr[position];
+		frames->mark[frame] = 0;
+		EntryListPush(queue, frames, frame);
+		if (PageIndexInsert(&run->index, arr[position], frame) != 0)
+			return -1;
+	}
+	run->stats.references += count;
+	return 0;
+}
+
+/*
+ * @brief - referenceLfu - least frequently used - the page referenced the fewest times since it was loaded is
+ *			replaced, the least recently used of them if there is a tie
+ *
+ * The frames are in a heap keyed by the number of references, with ties broken by the position of the last one, so
+ * a reference or a fault takes time in proportion to the log of the number of frames.
+ */
+int referenceLfu(struct_replacement_run *run, const int *arr, int count)
+{
+	int index, frame;
+
+	for (index = 0; index < count; index++, run->position++)
+	{
+		if ((frame = PageIndexFind(&run->index, arr[index])) >= 0)
+		{
+			EntryHeapUpdate(&run->heap, frame, run->heap.key[frame] + 1, run->position);
+			continue;
+		}
+		run->stats.faults++;
+		if (run->used < run->frameSize)
+		{
+			frame = run->used++;
+			EntryHeapPush(&run->heap, frame, 1, run->position);
+		}
+		else
+		{
+			frame = run->heap.heap[0];
+			PageIndexRemove(&run->index, run->pages[frame]);
+			EntryHeapUpdate(&run->heap, frame, 1, run->position); //the count starts again for the new page
+			run->stats.evictions++;
+		}
+		run->pages[frame] = arr[index];
+		if (PageIndexInsert(&run->index, arr[index], frame) != 0)
+			return -1;
+	}
+	run->stats.references += count;
+	return 0;
+}
+
+/*
+ * @brief - referenceArc - adaptive replacement cache (Megiddo and Modha)
+ *
+ * The frames are split between T1, the pages referenced once recently, and T2, the pages referenced more than once,
+ * with each list in LRU order. The pages replaced from them are remembered in B1 and B2, up to frameSize pages in
+ * all. A fault on a page remembered in B1 means T1 was too small, so its target size grows, and one in B2 means it
+ * shrinks. The mark of an entry is the list it is in. Each reference takes the same time however many frames there are.
+ */
+int referenceArc(struct_replacement_run *run, const int *arr, int count)
+{
+	struct_entry_list *lists = run->lists;
+	struct_entries *entries = &run->entries;
+	int position, entry, list, delta, frameSize = run->frameSize;
+
+	for (position = 0; position < count; position++)
+	{
+		if ((entry = PageIndexFind(&run->index, arr[position])) >= 0 &&
+		        (entries->mark[entry] == ARC_T1 || entries->mark[entry] == ARC_T2)) //in the frames
+		{
+			EntryListRemove(&lists[entries->mark[entry]], entries, entry);
+			entries->mark[entry] = ARC_T2;
+			EntryListPush(&lists[ARC_T2], entries, entry);
+			continue;
+		}
+		run->stats.faults++;
+		if (entry >= 0) //remembered - change the target, then bring the page back into T2
+		{
+			list = entries->mark[entry];
+			if (list == ARC_B1)
+			{
+				delta = lists[ARC_B2].size / lists[ARC_B1].size;
+				run->target += delta > 1 ? delta : 1;
+				if (run->target > frameSize)
+					run->target = frameSize;
+			}
+			else
+			{
+				delta = lists[ARC_B1].size / lists[ARC_B2].size;
+				run->target -= delta > 1 ? delta : 1;
+				if (run->target < 0)
+					run->target = 0;
+			}
+			arcReplace(run, list == ARC_B2);
+			EntryListRemove(&lists[list], entries, entry);
+			entries->mark[entry] = ARC_T2;
+			EntryListPush(&lists[ARC_T2], entries, entry);
+			continue;
+		}
+
+		entry = -1; //a new page - make room for it and put it in T1
+		if (lists[ARC_T1].size + lists[ARC_B1].size == frameSize)
+		{
+			if (lists[ARC_T1].size < frameSize) //forget the oldest page in B1
+			{
+				entry = lists[ARC_B1].tail;
+				EntryListRemove(&lists[ARC_B1], entries, entry);
+				PageIndexRemove(&run->index, entries->page[entry]);
+				arcReplace(run, 0);
+			}
+			else //B1 is empty - replace the oldest page in T1 without remembering it
+			{
+				entry = lists[ARC_T1].tail;
+				EntryListRemove(&lists[ARC_T1], entries, entry);
+				PageIndexRemove(&run->index, entries->page[entry]);
+				run->stats.evictions++;
+			}
+		}
+		else if (lists[ARC_T1].size + lists[ARC_T2].size + lists[ARC_B1].size + lists[ARC_B2].size >= frameSize)
+		{
+			if (lists[ARC_T1].size + lists[ARC_T2].size + lists[ARC_B1].size + lists[ARC_B2].size == 2 * frameSize)
+			{
+				entry = lists[ARC_B2].tail; //forget the oldest page in B2
+				EntryListRemove(&lists[ARC_B2], entries, entry);
+				PageIndexRemove(&run->index, entries->page[entry]);
+			}
+			arcReplace(run, 0);
+		}
+		if (entry < 0) //no page was forgotten, so there is an entry that has not been used yet
+			entry = run->used++;
+		entries->page[entry] = arr[position];
+		entries->mark[entry] = ARC_T1;
+		EntryListPush(&lists[ARC_T1], entries, entry);
+		if (PageIndexInsert(&run->index, arr[position], entry) != 0)
+			return -1;
+	}
+	run->stats.references += count;
+	return 0;
+}
+
+/*
+ * @brief - arcReplace - the REPLACE step of ARC - moves the oldest page of T1 to B1 if T1 is over its target, or
+ *			the oldest page of T2 to B2 otherwise, freeing a frame
+ *
+ * Inputs: inB2 - 1 if the page being brought in is remembered in B2, which also replaces from T1 when T1 is at its target
+ */
+void arcReplace(struct_replacement_run *run, int inB2)
+{
+	struct_entry_list *lists = run->lists;
+	int from = ARC_T2, to = ARC_B2, entry;
+
+	if (lists[ARC_T1].size > 0 &&
+	        ((inB2 && lists[ARC_T1].size == run->target) || lists[ARC_T1].size > run->target || lists[ARC_T2].size == 0))
+	{
+		from = ARC_T1;
+		to = ARC_B1;
+	}
+	entry = lists[from].tail;
+	EntryListRemove(&lists[from], &run->entries, entry);
+	run->entries.mark[entry] = to;
+	EntryListPush(&lists[to], &run->entries, entry);
+	run->stats.evictions++;
+}
+
+/*
+ * @brief - referenceOptimal - keeps a chunk of the reference string for finishOptimal, which needs to see the future
+ *
+ * This is the one policy that holds the whole reference string in memory, as page numbers - unless the next uses of
+ * the whole string have been found for it, when the pages of the chunk are replaced straight away instead. Returns -1
+ * if there is not enough memory or the string is too long to number its references with an int.
+ */
+int referenceOptimal(struct_replacement_run *run, const int *arr, int count)
+{
+	int *trace;
+	long long capacity;
+
+	if (run->nextUse != NULL)
+	{
+		if (optimalReplace(run, arr, run->nextUse + run->stats.references, count) != 0)
+			return -1;
+		run->stats.references += count;
+		return 0;
+	}
+	if (run->stats.references + count > run->traceCapacity)
+	{
+		capacity = run->traceCapacity > 0 ? run->traceCapacity * 2 : TRACE_CHUNK;
+		if (capacity < run->stats.references + count)
+			capacity = run->stats.references + count;
+		if (capacity > INT_MAX)
+			capacity = INT_MAX;
+		if (run->stats.references + count > capacity ||
+		        (trace = realloc(run->trace, sizeof (int) * (size_t) capacity)) == NULL)
+			return -1;
+		run->trace = trace;
+		run->traceCapacity = capacity;
+	}
+	memcpy(run->trace + run->stats.references, arr, sizeof (int) * count);
+	run->stats.references += count;
+	return 0;
+}
+
+/*
+ * @brief - finishOptimal - Belady's optimal algorithm - the page whose next reference is furthest away is replaced
+ *
+ * The position of the next reference to the same page is found for every reference in one pass backwards over the
+ * string, so nothing has to be looked for ahead. The frames are in a heap keyed by the next reference of their page,
+ * negated so the furthest is at the top, so a reference or a fault takes time in proportion to the log of the number
+ * of frames. A page that is not referenced again is given the position after the end of the string. A run given the
+ * next uses of a batch has already been replaced by referenceOptimal.
+ */
+int finishOptimal(struct_replacement_run *run)
+{
+	int count = (int) run->stats.references, position, result;
+	int *arr = run->trace;
+	int *nextUse; //position of the next reference to the same page
+
+	if (run->nextUse != NULL)
+		return 0;
+	if ((nextUse = malloc(sizeof (int) * (count > 0 ? count : 1))) == NULL)
+		return -1;
+	for (position = count - 1; position >= 0; position--) //the index holds the first position of each page after this one
+	{
+		nextUse[position] = PageIndexFind(&run->index, arr[position]);
+		if (nextUse[position] < 0)
+			nextUse[position] = count;
+		if (PageIndexInsert(&run->index, arr[position], position) != 0)
+		{
+			free(nextUse);
+			return -1;
+		}
+	}
+	PageIndexFree(&run->index);
+	result = PageIndexInit(&run->index, run->frameSize, arr, count) == 0 ? optimalReplace(run, arr, nextUse, count) : -1;
+	free(nextUse);
+	return result;
+}
+
+/*
+ * @brief - optimalReplace - replaces the pages of count references for opt, given the position of the next reference
+ *			to the same page of each
+ *
+ * Returns 0 on success or -1 if there is not enough memory.
+ */
+int optimalReplace(struct_replacement_run *run, const int *arr, const int *nextUse, int count)
+{
+	int position, frame;
+
+	for (position = 0; position < count; position++)
+	{
+		if ((frame = PageIndexFind(&run->index, arr[position])) >= 0)
+		{
+			EntryHeapUpdate(&run->heap, frame, -(long long) nextUse[position], 0);
+			continue;
+		}
+		run->stats.faults++;
+		if (run->used < run->frameSize)
+		{
+			frame = run->used++;
+			EntryHeapPush(&run->heap, frame, -(long long) nextUse[position], 0);
+		}
+		else
+		{
+			frame = run->heap.heap[0];
+			PageIndexRemove(&run->index, run->pages[frame]);
+			EntryHeapUpdate(&run->heap, frame, -(long long) nextUse[position], 0);
+			run->stats.evictions++;
+		}
+		run->pages[frame] = arr[position];
+		if (PageIndexInsert(&run->index, arr[position], frame) != 0)
+			return -1;
+	}
+	return 0;
+}
+
+/*
+ * @brief - EntriesInit - creates size entries that are in no list, with their marks clear
+ *
+ * Returns 0 on success or -1 if there is not enough memory.
+ */
+int EntriesInit(struct_entries *entries, int size)
+{
+	entries->page = malloc(sizeof (int) * size * 4); //every array is in one block
+	if (entries->page == NULL)
+		return -1;
+	entries->prev = entries->page + size;
+	entries->next = entries->page + size * 2;
+	entries->mark = entries->page + size * 3;
+	memset(entries->mark, 0, sizeof (int) * size);
+	return 0;
+}
+
+void EntriesFree(struct_entries *entries)
+{
+	free(entries->page); //the start of the block holding every array
+	entries->page = NULL;
+}
+
+/*
+ * @brief - EntryListPush - puts an entry that is in no list at the head of a list
+ */
+void EntryListPush(struct_entry_list *list, struct_entries *entries, int entry)
+{
+	entries->prev[entry] = -1;
+	entries->next[entry] = list->head;
+	if (list->head >= 0)
+		entries->prev[list->head] = entry;
+	else
+		list->tail = entry;
+	list->head = entry;
+	list->size++;
+}
+
+/*
+ * @brief - EntryListRemove - takes an entry out of the list it is in
+ */
+void EntryListRemove(struct_entry_list *list, struct_entries *entries, int entry)
+{
+	if (entries->prev[entry] >= 0)
+		entries->next[entries->prev[entry]] = entries->next[entry];
+	else
+		list->head = entries->next[entry];
+	if (entries->next[entry] >= 0)
+		entries->prev[entries->next[entry]] = entries->prev[entry];
+	else
+		list->tail = entries->prev[entry];
+	list->size--;
+}
+
+/*
+ * @brief - EntryHeapInit - creates an empty heap with room for the entries 0 to size - 1
+ *
+ * Returns 0 on success or -1 if there is not enough memory.
+ */
+int EntryHeapInit(struct_entry_heap *heap, int size)
+{
+	heap->size = 0;
+	heap->heap = malloc(sizeof (int) * size);
+	heap->position = malloc(sizeof (int) * size);
+	heap->key = malloc(sizeof (long long) * size);
+	heap->tie = malloc(sizeof (long long) * size);
+	return heap->heap != NULL && heap->position != NULL && heap->key != NULL && heap->tie != NULL ? 0 : -1;
+}
+
+void EntryHeapFree(struct_entry_heap *heap)
+{
+	free(heap->heap);
+	free(heap->position);
+	free(heap->key);
+	free(heap->tie);
+	heap->heap = heap->position = NULL;
+	heap->key = heap->tie = NULL;
+}
+
+/*
+ * @brief - EntryHeapPush - adds an entry that is not in the heap
+ */
+void EntryHeapPush(struct_entry_heap *heap, int entry, long long key, long long tie)
+{
+	heap->key[entry] = key;
+	heap->tie[entry] = tie;
+	EntryHeapMove(heap, entry, heap->size++);
+}
+
+/*
+ * @brief - EntryHeapUpdate - changes the key of an entry in the heap and moves it to its place
+ */
+void EntryHeapUpdate(struct_entry_heap *heap, int entry, long long key, long long tie)
+{
+	heap->key[entry] = key;
+	heap->tie[entry] = tie;
+	EntryHeapMove(heap, entry, heap->position[entry]);
+}
+
+/*
+ * @brief - EntryHeapCompare - less than 0 if an entry comes before a key and tie in the heap, 0 if they are the same,
+ *			more than 0 if it comes after
+ */
+int EntryHeapCompare(const struct_entry_heap *heap, int entry, long long key, long long tie)
+{
+	if (heap->key[entry] != key)
+		return heap->key[entry] < key ? -1 : 1;
+	return heap->tie[entry] < tie ? -1 : heap->tie[entry] > tie;
+}
+
+/*
+ * @brief - EntryHeapMove - puts an entry at a position of the heap, then sifts it up or down until the heap is in order
+ */
+void EntryHeapMove(struct_entry_heap *heap, int entry, int position)
+{
+	long long key = heap->key[entry], tie = heap->tie[entry];
+	int parent, child;
+
+	while (position > 0 && EntryHeapCompare(heap, heap->heap[parent = (position - 1) / 2], key, tie) > 0) //up
+	{
+		heap->heap[position] = heap->heap[parent];
+		heap->position[heap->heap[position]] = position;
+		position = parent;
+	}
+	while ((child = position * 2 + 1) < heap->size) //down
+	{
+		if (child + 1 < heap->size &&
+		        EntryHeapCompare(heap, heap->heap[child + 1], heap->key[heap->heap[child]], heap->tie[heap->heap[child]]) < 0)
+			child++;
+		if (EntryHeapCompare(heap, heap->heap[child], key, tie) >= 0)
+			break;
+		heap->heap[position] = heap->heap[child];
+		heap->position[heap->heap[position]] = position;
+		position = child;
+	}
+	heap->heap[position] = entry;
+	heap->position[entry] = position;
+}
+
+/* ************************ End of Methods and functions for comparing page replacement policies **************************** */
+
+/* ************************ Methods and functions for fault curves **************************** */
+
+/*
+ * @brief - computeFaultCurve - finds the faults of every policy of a curve with every number of frames from 1 to
+ *			curve->frames, in one pass over a trace
+ *
+ * Inputs: *arr - room for TRACE_CHUNK references
+ *
+ * LRU is a stack algorithm - the pages it holds in f frames are always among those it holds in f + 1 - so its faults
+ * for every number of frames come from the stack distances of the references, in time in proportion to n log n.
+ * FIFO and the other policies are not, so each chunk of the trace is given to a run of the policy with every number
+ * of frames in turn, which takes time in proportion to the number of references times the number of frames. With as
+ * many frames as the trace has pages no policy replaces a page, so when the trace can be read again its pages are
+ * counted first, and the runs stop one frame short of that. With curve->workers the runs are shared out between
+ * worker threads by faultCurveBatch, and the stack distances are found on this thread.
+ * Returns 0 on success, or -1 if the trace is not valid or there is not enough memory, after printing why.
+ */
+int computeFaultCurve(struct_trace_reader *trace, int *arr, struct_fault_curve *curve)
+{
+	struct_stack_distance stack;
+	struct_replacement_run *runs = NULL; //a run of each policy apart from lru with each number of frames simulated
+	const struct_replacement_policy *policy;
+	long long *stackFaults = NULL; //faults of lru with each number of frames
+	int frames = curve->frames, simulated = frames, distinct = -1, index, frameSize, count = 0, useStack = 0, result = 0;
+	int batched = curve->workers > 0 && simulated > 0;
+
+	for (index = 0; index < curve->numOfPolicies; index++)
+		if (curve->policies[index]->reference == referenceLru)
+			useStack = 1;
+	if (trace->buffer == NULL) //a file or the built-in string, which can be read again
+	{
+		if ((distinct = countTracePages(trace, arr)) < 0)
+			return -1;
+		if (distinct <= frames) //every policy faults once for each page and never again
+			simulated = distinct > 0 ? distinct - 1 : 0;
+		batched = curve->workers > 0 && simulated > 0;
+	}
+	memset(&stack, 0, sizeof (struct_stack_distance));
+	if (batched)
+		result = faultCurveBatch(trace, curve, simulated);
+	else if ((runs = calloc((size_t) curve->numOfPolicies * simulated + 1, sizeof (struct_replacement_run))) == NULL)
+		result = -1;
+
+	if (result == 0 && (useStack || !batched) && (count = TraceRead(trace, arr, TRACE_CHUNK)) < 0)
+		result = -2; //TraceRead has said why
+	for (index = 0; index < curve->numOfPolicies && result == 0; index++)
+	{
+		policy = curve->policies[index];
+		if (policy->reference == referenceLru) //the stack algorithm
+		{
+			if (stack.tree == NULL)
+				result = StackDistanceInit(&stack, frames, arr, count);
+		}
+		else if (!batched) //the runs only use the hash table of the page index, as there are so many of them
+			for (frameSize = 1; frameSize <= simulated && result == 0; frameSize++)
+				result = ReplacementRunInit(&runs[index * simulated + frameSize - 1], policy, frameSize, NULL, 0);
+	}
+
+	while (count > 0 && result == 0)
+	{
+		for (index = 0; index < curve->numOfPolicies && result == 0 && !batched; index++)
+			if (curve->policies[index]->reference != referenceLru)
+				for (frameSize = 1; frameSize <= simulated && result == 0; frameSize++)
+					result = curve->policies[index]->reference(&runs[index * simulated + frameSize - 1], arr, count);
+		if (useStack && result == 0)
+			result = stackDistanceReference(&stack, arr, count);
+		if (result == 0 && (count = TraceRead(trace, arr, TRACE_CHUNK)) < 0)
+			result = -2;
+	}
+	if (result == 0 && (useStack || !batched)) //otherwise faultCurveBatch has counted them
+		curve->references = trace->references;
+	if (result == 0 && useStack && (stackFaults = malloc(sizeof (long long) * frames)) == NULL)
+		result = -1;
+	if (result == -1)
+		printf("Not enough memory for the faults with every number of frames up to %d\n", frames);
+
+	if (result == 0)
+	{
+		if (useStack)
+			stackDistanceFaults(&stack, stackFaults);
+		for (index = 0; index < curve->numOfPolicies; index++)
+			for (frameSize = 1; frameSize <= frames; frameSize++)
+				if (curve->policies[index]->reference == referenceLru)
+					curve->faults[index * frames + frameSize - 1] = stackFaults[frameSize - 1];
+				else if (frameSize > simulated)
+					curve->faults[index * frames + frameSize - 1] = distinct;
+				else if (!batched) //faultCurveBatch has put in the others
+					curve->faults[index * frames + frameSize - 1] = runs[index * simulated + frameSize - 1].stats.faults;
+	}
+	for (index = 0; runs != NULL && index < curve->numOfPolicies * simulated; index++)
+		ReplacementRunFree(&runs[index]);
+	free(runs);
+	free(stackFaults);
+	StackDistanceFree(&stack);
+	return result == 0 ? 0 : -1;
+}
+
+/*
+ * @brief - countTracePages - the number of different pages in a trace that can be read again, read with a cursor of
+ *			its own so the trace is left at its start
+ *
+ * Inputs: *arr - room for TRACE_CHUNK references
+ *
+ * Returns the number of pages, or -1 after printing why if the trace is not valid or there is not enough memory.
+ */
+int countTracePages(const struct_trace_reader *trace, int *arr)
+{
+	struct_trace_reader cursor;
+	struct_page_index pages;
+	int count, index, distinct = 0;
+
+	TraceShare(trace, &cursor);
+	if ((count = TraceRead(&cursor, arr, TRACE_CHUNK)) < 0)
+		return -1;
+	if (PageIndexInit(&pages, count, arr, count) != 0) //room for the pages of the first chunk, and it grows
+		distinct = -2;
+	while (count > 0 && distinct >= 0)
+	{
+		for (index = 0; index < count && distinct >= 0; index++)
+			if (PageIndexFind(&pages, arr[index]) < 0)
+				distinct = PageIndexInsert(&pages, arr[index], 0) == 0 ? distinct + 1 : -2;
+		if (distinct >= 0 && (count = TraceRead(&cursor, arr, TRACE_CHUNK)) < 0)
+			distinct = -1; //TraceRead has said why
+	}
+	if (distinct == -2)
+		printf("Not enough memory to count the pages of the trace\n");
+	PageIndexFree(&pages);
+	return distinct < 0 ? -1 : distinct;
+}
+
+/*
+ * @brief - faultCurveBatch - runs every policy of a curve apart from lru with every number of frames from 1 to
+ *			simulated on curve->workers worker threads, and puts their faults in the curve
+ *
+ * The runs of each policy are in order of number of frames, so runBatch gives each worker some small and some large
+ * ones. Returns 0 on success or -2 after printing why.
+ */
+int faultCurveBatch(struct_trace_reader *trace, struct_fault_curve *curve, int simulated)
+{
+	struct_batch batch;
+	int index, run, frameSize, numOfPolicies = 0, result = -2;
+
+	memset(&batch, 0, sizeof (struct_batch));
+	for (index = 0; index < curve->numOfPolicies; index++)
+		if (curve->policies[index]->reference != referenceLru)
+			numOfPolicies++;
+	if (numOfPolicies == 0)
+		return 0;
+	if ((long long) numOfPolicies * simulated > INT_MAX)
+	{
+		printf("Not enough memory for the faults with every number of frames up to %d\n", curve->frames);
+		return -2;
+	}
+	batch.trace = trace;
+	batch.workers = curve->workers;
+	batch.numOfRuns = numOfPolicies * simulated;
+	batch.hashOnly = 1;
+	batch.policies = malloc(sizeof (const struct_replacement_policy *) * batch.numOfRuns);
+	batch.frameSizes = malloc(sizeof (int) * batch.numOfRuns);
+	batch.results = malloc(sizeof (struct_replacement_stats) * batch.numOfRuns);
+	if (batch.policies == NULL || batch.frameSizes == NULL || batch.results == NULL)
+		perror("malloc");
+	else
+	{
+		for (index = 0, run = 0; index < curve->numOfPolicies; index++)
+			if (curve->policies[index]->reference != referenceLru)
+				for (frameSize = 1; frameSize <= simulated; frameSize++, run++)
+				{
+					batch.policies[run] = curve->policies[index];
+					batch.frameSizes[run] = frameSize;
+				}
+		if (runBatch(&batch) == 0)
+		{
+			for (index = 0, run = 0; index < curve->numOfPolicies; index++)
+				if (curve->policies[index]->reference != referenceLru)
+					for (frameSize = 1; frameSize <= simulated; frameSize++, run++)
+						curve->faults[index * curve->frames + frameSize - 1] = batch.results[run].faults;
+			curve->references = batch.references;
+			result = 0;
+		}
+	}
+	free(batch.policies);
+	free(batch.frameSizes);
+	free(batch.results);
+	return result;
+}
+
+/*
+ * @brief - printFaultCurve - prints the faults and miss ratio of each policy with every number of frames
+ *
+ * A number of frames with more faults than one frame fewer - Belady's anomaly, which a stack algorithm never shows -
+ * is marked with a *.
+ */
+void printFaultCurve(const struct_fault_curve *curve)
+{
+	int index, frameSize, anomalies;
+	long long faults, fewer;
+
+	printf("\n------------------------------------------------------------\n");
+	printf("  Faults for every number of frames over %lld references\n", curve->references);
+	printf("  Frames");
+	for (index = 0; index < curve->numOfPolicies; index++)
+		printf(" %13s  %9s", curve->policies[index]->name, "Miss");
+	printf("\n");
+	for (frameSize = 1; frameSize <= curve->frames; frameSize++)
+	{
+		printf("  %6d", frameSize);
+		for (index = 0; index < curve->numOfPolicies; index++)
+		{
+			faults = curve->faults[index * curve->frames + frameSize - 1];
+			fewer = frameSize > 1 ? curve->faults[index * curve->frames + frameSize - 2] : faults;
+			printf(" %13lld%c %8.2f%%", faults, faults > fewer ? '*' : ' ',
+			       curve->references > 0 ? 100.0 * faults / curve->references : 0.0);
+		}
+		printf("\n");
+	}
+	printf("\n");
+	for (index = 0; index < curve->numOfPolicies; index++)
+	{
+		for (anomalies = 0, frameSize = 2; frameSize <= curve->frames; frameSize++)
+			if (curve->faults[index * curve->frames + frameSize - 1] > curve->faults[index * curve->frames + frameSize - 2])
+				anomalies++;
+		printf("  %s: %d numbers of frames with more faults than one frame fewer (*, Belady's anomaly)\n",
+		       curve->policies[index]->name, anomalies);
+	}
+	printf("------------------------------------------------------------\n");
+}
+
+/*
+ * @brief - StackDistanceInit - starts counting the stack distances of a trace, up to frames
+ *
+ * Inputs: *arr, count - the first chunk of the trace, used to size the page index
+ *
+ * Returns 0 on success or -1 if there is not enough memory.
+ */
+int StackDistanceInit(struct_stack_distance *stack, int frames, const int *arr, int count)
+{
+	memset(stack, 0, sizeof (struct_stack_distance));
+	stack->frames = frames;
+	stack->capacity = STACK_TIMES_START;
+	stack->tree = calloc(stack->capacity + 1, sizeof (int));
+	stack->timePage = malloc(sizeof (int) * stack->capacity);
+	stack->distances = calloc(frames + 2, sizeof (long long));
+	if (stack->tree == NULL || stack->timePage == NULL || stack->distances == NULL ||
+	        PageIndexInit(&stack->lastTime, frames, arr, count) != 0)
+	{
+		StackDistanceFree(stack);
+		return -1;
+	}
+	return 0;
+}
+
+void StackDistanceFree(struct_stack_distance *stack)
+{
+	PageIndexFree(&stack->lastTime);
+	free(stack->tree);
+	free(stack->timePage);
+	free(stack->distances);
+	memset(stack, 0, sizeof (struct_stack_distance));
+}
+
+/*
+ * @brief - stackDistanceReference - counts the stack distances of the next count references of the trace
+ *
+ * Returns 0 on success or -1 if there is not enough memory.
+ */
+int stackDistanceReference(struct_stack_distance *stack, const int *arr, int count)
+{
+	int index, time, distance;
+
+	for (index = 0; index < count; index++)
+	{
+		if (stack->now == stack->capacity && StackDistanceRenumber(stack) != 0)
+			return -1;
+		if ((time = PageIndexFind(&stack->lastTime, arr[index])) < 0)
+		{
+			stack->firstReferences++;
+			stack->pages++;
+		}
+		else //the pages referenced since are those whose last reference is after time
+		{
+			distance = stack->pages - FenwickSum(stack->tree, time) + 1;
+			stack->distances[distance <= stack->frames ? distance : stack->frames + 1]++;
+			FenwickAdd(stack->tree, stack->capacity, time, -1);
+			stack->timePage[time] = -1;
+		}
+		FenwickAdd(stack->tree, stack->capacity, stack->now, 1);
+		stack->timePage[stack->now] = arr[index];
+		if (PageIndexInsert(&stack->lastTime, arr[index], stack->now) != 0)
+			return -1;
+		stack->now++;
+	}
+	return 0;
+}
+
+/*
+ * @brief - StackDistanceRenumber - numbers the times of the last reference to each page again from 0, keeping their
+ *			order, once every time the tree covers has been used
+ *
+ * The tree is made larger first if it would be more than half full, so that renumbering takes time in proportion to
+ * the number of references since it was last done. Returns 0 on success or -1 if there is not enough memory.
+ */
+int StackDistanceRenumber(struct_stack_distance *stack)
+{
+	int capacity = stack->capacity, time, next = 0, parent;
+	int *timePage, *tree;
+
+	while (stack->pages > capacity / 2)
+		capacity *= 2;
+	if (capacity != stack->capacity)
+	{
+		if ((timePage = realloc(stack->timePage, sizeof (int) * capacity)) == NULL)
+			return -1;
+		stack->timePage = timePage;
+		if ((tree = malloc(sizeof (int) * (capacity + 1))) == NULL)
+			return -1;
+		free(stack->tree);
+		stack->tree = tree;
+	}
+	for (time = 0; time < stack->now; time++)
+		if (stack->timePage[time] >= 0)
+		{
+			stack->timePage[next] = stack->timePage[time];
+			PageIndexInsert(&stack->lastTime, stack->timePage[next], next); //the page is in the index, so it cannot fail
+			next++;
+		}
+
+	memset(stack->tree, 0, sizeof (int) * (capacity + 1)); //build the tree with a 1 at each of the first next times
+	for (time = 1; time <= next; time++)
+		stack->tree[time] = 1;
+	for (time = 1; time <= capacity; time++)
+		if ((parent = time + (time & -time)) <= capacity)
+			stack->tree[parent] += stack->tree[time];
+	stack->capacity = capacity;
+	stack->now = next;
+	return 0;
+}
+
+/*
+ * @brief - stackDistanceFaults - the faults of LRU with each number of frames from 1 to stack->frames
+ *
+ * With f frames every reference with a stack distance over f is a fault, as is the first reference to each page.
+ */
+void stackDistanceFaults(const struct_stack_distance *stack, long long *faults)
+{
+	long long total = stack->firstReferences + stack->distances[stack->frames + 1];
+	int frameSize;
+
+	for (frameSize = stack->frames; frameSize >= 1; frameSize--)
+	{
+		faults[frameSize - 1] = total;
+		total += stack->distances[frameSize];
+	}
+}
+
+/*
+ * @brief - FenwickAdd - adds a value to a time of a Fenwick tree covering the times 0 to capacity - 1
+ */
+void FenwickAdd(int *tree, int capacity, int time, int value)
+{
+	for (time++; time <= capacity; time += time & -time)
+		tree[time] += value;
+}
+
+/*
+ * @brief - FenwickSum - the sum of the values of a Fenwick tree at the times 0 to time
+ */
+int FenwickSum(const int *tree, int time)
+{
+	int sum = 0;
+	for (time++; time > 0; time -= time & -time)
+		sum += tree[time];
+	return sum;
+}
+
+/* ************************ End of Methods and functions for fault curves **************************** */
+
+/* ************************ Methods and functions for batches of runs **************************** */
+
+/*
+ * @brief - parseFrameSizes - reads the numbers of frames of a batch given with -w - numbers, and ranges such as 16-32,
+ *			separated by commas
+ *
+ * Returns the number of frame sizes put in *frameSizes, a new array, or -1 after printing why if the list is not valid.
+ */
+int parseFrameSizes(const char *text, int **frameSizes)
+{
+	long from, to, size;
+	char *end = NULL;
+	int count = 0, valid = 1;
+
+	if ((*frameSizes = malloc(sizeof (int) * BATCH_FRAME_SIZE_LIMIT)) == NULL)
+	{
+		perror("malloc");
+		return -1;
+	}
+	while (valid)
+	{
+		valid = isdigit((unsigned char) *text);
+		from = to = strtol(text, &end, 10);
+		if (valid && *end == '-')
+		{
+			valid = isdigit((unsigned char) end[1]);
+			to = strtol(end + 1, &end, 10);
+		}
+		valid = valid && from >= 1 && to >= from && to <= INT_MAX && to - from < BATCH_FRAME_SIZE_LIMIT - count &&
+		        (*end == 0 || *end == ',');
+		for (size = from; valid && size <= to; size++)
+			(*frameSizes)[count++] = (int) size;
+		if (valid && *end == 0)
+			return count;
+		text = end + 1;
+	}
+	printf("The numbers of frames of a batch are numbers from 1, and ranges such as 16-32, separated by commas - "
+	       "up to %d of them\n", BATCH_FRAME_SIZE_LIMIT);
+	free(*frameSizes);
+	*frameSizes = NULL;
+	return -1;
+}
+
+/*
+ * @brief - runBatch - runs every run of a batch on batch->workers worker threads
+ *
+ * Each worker runs its share of the runs together, in one pass over the trace with a cursor of its own, so the trace
+ * is parsed once by each worker rather than once for each run, and the workers never wait for each other. The share
+ * of each worker is every workers-th run, so that with the runs in order of policy and number of frames each worker
+ * is given some of the runs of each policy, large and small, and they take about as long as each other. opt needs
+ * to see the future, so if there are opt runs the next use of every reference is found first, once for all of them,
+ * instead of each run keeping a copy of the trace.
+ * Returns 0 on success or -1 after printing why if a run failed or a worker could not be started.
+ */
+int runBatch(struct_batch *batch)
+{
+	struct_batch_worker *workers;
+	pthread_t *threads;
+	int *arr;
+	int index, started, error, result = 0;
+
+	if (batch->workers > batch->numOfRuns) //a worker with no runs would have nothing to do
+		batch->workers = batch->numOfRuns;
+	batch->nextUse = NULL;
+	for (index = 0; index < batch->numOfRuns; index++)
+		if (batch->policies[index]->reference == referenceOptimal)
+			break;
+	if (index < batch->numOfRuns)
+	{
+		if ((arr = malloc(sizeof (int) * TRACE_CHUNK)) == NULL)
+		{
+			perror("malloc");
+			return -1;
+		}
+		batch->nextUse = findNextUses(batch->trace, arr);
+		free(arr);
+		if (batch->nextUse == NULL)
+			return -1;
+	}
+	workers = malloc(sizeof (struct_batch_worker) * batch->workers);
+	threads = malloc(sizeof (pthread_t) * batch->workers);
+	if (workers == NULL || threads == NULL)
+	{
+		perror("malloc");
+		free(workers);
+		free(threads);
+		free(batch->nextUse);
+		return -1;
+	}
+	for (started = 0; started < batch->workers; started++)
+	{
+		workers[started].batch = batch;
+		workers[started].worker = started;
+		if ((error = pthread_create(&threads[started], NULL, (void *)batchWorker, &workers[started])) != 0)
+		{
+			printf("Cannot start worker thread %d: %s\n", started + 1, strerror(error));
+			result = -1;
+			break;
+		}
+	}
+	for (index = 0; index < started; index++)
+	{
+		pthread_join(threads[index], NULL);
+		if (workers[index].result != 0)
+			result = -1;
+		batch->references = workers[index].references;
+	}
+	free(workers);
+	free(threads);
+	free(batch->nextUse);
+	batch->nextUse = NULL;
+	return result;
+}
+
+/*
+ * @brief - batchWorker - a worker thread of runBatch, which runs every batch->workers-th run from worker->worker
+ *
+ * Its runs are gathered into arrays of their own for runReplacementPolicies, and their results put back in the batch,
+ * where no other worker writes to them.
+ */
+void *batchWorker(struct_batch_worker *worker)
+{
+	struct_batch *batch = worker->batch;
+	struct_trace_reader cursor;
+	const struct_replacement_policy **policies;
+	struct_replacement_stats *results;
+	int *frameSizes, *arr;
+	int numOfRuns = (batch->numOfRuns - worker->worker + batch->workers - 1) / batch->workers, index;
+
+	policies = malloc(sizeof (const struct_replacement_policy *) * numOfRuns);
+	results = malloc(sizeof (struct_replacement_stats) * numOfRuns);
+	frameSizes = calloc(numOfRuns, sizeof (int));
+	arr = malloc(sizeof (int) * TRACE_CHUNK);
+	worker->result = -1;
+	worker->references = 0;
+	if (policies == NULL || results == NULL || frameSizes == NULL || arr == NULL)
+		perror("malloc");
+	else
+	{
+		for (index = 0; index < numOfRuns; index++)
+		{
+			policies[index] = batch->policies[worker->worker + index * batch->workers];
+			frameSizes[index] = batch->frameSizes[worker->worker + index * batch->workers];
+		}
+		TraceShare(batch->trace, &cursor);
+		worker->result = runReplacementPolicies(&cursor, arr, policies, frameSizes, numOfRuns, batch->hashOnly,
+		                                        batch->nextUse, results);
+		for (index = 0; worker->result == 0 && index < numOfRuns; index++)
+			batch->results[worker->worker + index * batch->workers] = results[index];
+		worker->references = cursor.references;
+	}
+	free(policies);
+	free(results);
+	free(frameSizes);
+	free(arr);
+	return NULL;
+}
+
+void printBatchResults(const struct_batch *batch)
+{
+	int index;
+	printf("\n------------------------------------------------------------\n");
+	printf("  Policy          Frames        Faults    Hit Ratio      Evictions\n");
+	for (index = 0; index < batch->numOfRuns; index++)
+		printf("  %-14s %7d %13lld %11.2f%% %14lld\n", batch->policies[index]->name, batch->frameSizes[index],
+		       batch->results[index].faults, batch->results[index].references > 0 ?
+		       100.0 * (batch->results[index].references - batch->results[index].faults) / batch->results[index].references :
+		       0.0, batch->results[index].evictions);
+	printf("------------------------------------------------------------\n");
+}
+
+/*
+ * @brief - findNextUses - the position of the next reference to the same page for every reference of a trace that
+ *			can be read again, read with a cursor of its own
+ *
+ * Inputs: *arr - room for TRACE_CHUNK references
+ *
+ * The trace is read forwards: each reference is the next use of the last reference to its page, which is kept in a
+ * page index, so the trace is never held in memory. A reference to a page that is not referenced again is given the
+ * position after the end of the trace, the same as in finishOptimal. Returns a new array with one int per reference,
+ * or NULL after printing why if the trace is not valid, is too long to number its references with an int, or there
+ * is not enough memory.
+ */
+int *findNextUses(const struct_trace_reader *trace, int *arr)
+{
+	struct_trace_reader cursor;
+	struct_page_index last; //position of the last reference to each page so far
+	int *nextUse = NULL, *grown;
+	long long capacity = 0, position = 0, end;
+	int count, index, previous, result = 0;
+
+	TraceShare(trace, &cursor);
+	if ((count = TraceRead(&cursor, arr, TRACE_CHUNK)) < 0)
+		return NULL;
+	if (PageIndexInit(&last, count, arr, count) != 0) //room for the pages of the first chunk, and it grows
+		result = -1;
+	while (count > 0 && result == 0)
+	{
+		if (position + count > capacity)
+		{
+			capacity = capacity > 0 ? capacity * 2 : TRACE_CHUNK;
+			if (capacity > INT_MAX)
+				capacity = INT_MAX;
+			if (position + count > capacity || (grown = realloc(nextUse, sizeof (int) * (size_t) capacity)) == NULL)
+			{
+				result = -1;
+				break;
+			}
+			nextUse = grown;
+		}
+		for (index = 0; index < count && result == 0; index++)
+		{
+			if ((previous = PageIndexFind(&last, arr[index])) >= 0)
+				nextUse[previous] = (int) (position + index);
+			nextUse[position + index] = -1; //until the page is referenced again
+			result = PageIndexInsert(&last, arr[index], (int) (position + index));
+		}
+		position += count;
+		if (result == 0 && (count = TraceRead(&cursor, arr, TRACE_CHUNK)) < 0)
+			result = -2; //TraceRead has said why
+	}
+	for (end = 0; result == 0 && end < position; end++)
+		if (nextUse[end] < 0)
+			nextUse[end] = (int) position;
+	if (result == -1)
+		printf("Not enough memory to find the next use of every reference for opt\n");
+	PageIndexFree(&last);
+	if (result != 0)
+	{
+		free(nextUse);
+		return NULL;
+	}
+	return nextUse != NULL ? nextUse : malloc(sizeof (int)); //an empty trace
+}
+
+/* ************************ End of Methods and functions for batches of runs **************************** */
+
+/* ************************ Methods and functions for reading reference traces **************************** */
+
+/*
+ * @brief - TraceOpen - opens a reference trace to be read a chunk at a time with TraceRead
+ *
+ * Inputs: *path - the trace file, "-" to read stdin, or NULL for the built-in REFERENCE_STRING
+ 			format - TRACE_TEXT, TRACE_BINARY32 or TRACE_BINARY64
+ 			pageSize - an address is divided by this to give its page number - 1 if the trace holds page numbers
+ *
+ * A regular file is memory-mapped, so the kernel reads it ahead and no copy of it is made; a pipe or terminal is read
+ * into a buffer of TRACE_BUFFER_BYTES. Returns 0 on success or -1 after printing why the trace could not be opened.
+ */
+int TraceOpen(struct_trace_reader *trace, const char *path, int format, unsigned long long pageSize)
+{
+	struct stat status;
+	void *data;
+
+	memset(trace, 0, sizeof (struct_trace_reader));
+	trace->fd = -1;
+	trace->format = format;
+	trace->pageSize = pageSize;
+	if (path == NULL)
+	{
+		trace->data = REFERENCE_STRING;
+		trace->length = strlen(REFERENCE_STRING);
+		return 0;
+	}
+
+	if ((trace->fd = strcmp(path, "-") == 0 ? dup(STDIN_FILENO) : open(path, O_RDONLY)) == -1 ||
+	        fstat(trace->fd, &status) == -1)
+	{
+		printf("Cannot open the trace %s: %s\n", path, strerror(errno));
+		TraceClose(trace);
+		return -1;
+	}
+	if (S_ISREG(status.st_mode) && status.st_size > 0 &&
+	        (data = mmap(NULL, status.st_size, PROT_READ, MAP_PRIVATE, trace->fd, 0)) != MAP_FAILED)
+	{
+		madvise(data, status.st_size, MADV_SEQUENTIAL);
+		trace->data = data;
+		trace->length = trace->mapped = status.st_size;
+		return 0;
+	}
+	if ((trace->buffer = malloc(TRACE_BUFFER_BYTES)) == NULL) //not a file that can be mapped - read it
+	{
+		perror("malloc");
+		TraceClose(trace);
+		return -1;
+	}
+	trace->data = trace->buffer;
+	return 0;
+}
+
+void TraceClose(struct_trace_reader *trace)
+{
+	if (trace->mapped > 0 && !trace->shared)
+		munmap((void *) trace->data, trace->mapped);
+	free(trace->buffer);
+	if (trace->fd != -1)
+		close(trace->fd);
+	trace->fd = -1;
+	trace->mapped = 0;
+	trace->buffer = NULL;
+}
+
+/*
+ * @brief - TraceRead - reads up to max page numbers from a trace
+ *
+ * Fewer than max are only read at the end of the trace. Returns the number read, 0 at the end of the trace, or -1
+ * after printing why if the trace is not valid or could not be read.
+ */
+int TraceRead(struct_trace_reader *trace, int *pages, int max)
+{
+	unsigned long long value, page;
+	int count, result = 1;
+
+	for (count = 0; count < max && (result = TraceNext(trace, &value)) > 0; count++)
+	{
+		page = value / trace->pageSize;
+		if (page > INT_MAX)
+		{
+			printf("Reference %lld of the trace is page %llu, more than %d - give a larger page size with -s\n",
+			       trace->references + 1, page, INT_MAX);
+			return -1;
+		}
+		pages[count] = (int) page;
+		trace->references++;
+	}
+	TraceRelease(trace);
+	return result < 0 ? -1 : count;
+}
+
+/*
+ * @brief - TraceNext - parses the next address, or page number, of a trace
+ *
+ * A text trace is parsed by hand rather than with sscanf, which is most of the time taken by reading a long trace:
+ * numbers are decimal, or hexadecimal after 0x, separated by white space or commas, and a # starts a comment that
+ * runs to the end of the line. Returns 1 for a value, 0 at the end of the trace, or -1 after printing why if the
+ * trace is not valid.
+ */
+int TraceNext(struct_trace_reader *trace, unsigned long long *value)
+{
+	const unsigned char *data;
+	size_t available, length;
+	unsigned long long number = 0;
+	uint32_t address32;
+	uint64_t address64;
+	int digit, base = 10;
+
+	if (trace->format != TRACE_TEXT)
+	{
+		if ((available = TraceAvailable(trace, trace->format)) < (size_t) trace->format)
+		{
+			if (available == 0 && !trace->failed)
+				return 0;
+			if (!trace->failed)
+				printf("The trace ends part of the way through an address\n");
+			return -1;
+		}
+		if (trace->format == TRACE_BINARY32)
+		{
+			memcpy(&address32, trace->data + trace->offset, sizeof address32);
+			*value = address32;
+		}
+		else
+		{
+			memcpy(&address64, trace->data + trace->offset, sizeof address64);
+			*value = address64;
+		}
+		trace->offset += trace->format;
+		return 1;
+	}
+
+	while (1) //skip white space, commas and comments
+	{
+		if ((available = TraceAvailable(trace, TRACE_TOKEN_BYTES)) == 0)
+			return trace->failed ? -1 : 0;
+		data = (const unsigned char *) trace->data + trace->offset;
+		for (length = 0; length < available && (isspace(data[length]) || data[length] == ','); length++)
+			;
+		if (length < available && data[length] == '#')
+			for (; length < available && data[length] != '\n'; length++)
+				;
+		trace->offset += length;
+		if (length == 0)
+			break;
+	}
+
+	if (available >= 2 && data[0] == '0' && (data[1] == 'x' || data[1] == 'X'))
+	{
+		base = 16;
+		data += 2;
+		available -= 2;
+		trace->offset += 2;
+	}
+	for (length = 0; length < available && length <= TRACE_TOKEN_BYTES; length++)
+	{
+		if (isdigit(data[length]))
+			digit = data[length] - '0';
+		else if (base == 16 && isxdigit(data[length]))
+			digit = tolower(data[length]) - 'a' + 10;
+		else
+			break;
+		if (number > (ULLONG_MAX - digit) / base)
+		{
+			printf("Reference %lld of the trace is too large\n", trace->references + 1);
+			return -1;
+		}
+		number = number * base + digit;
+	}
+	if (length == 0 || (length < available && !isspace(data[length]) && data[length] != ',' && data[length] != '#'))
+	{
+		printf("Reference %lld of the trace is not a page number: \"%.*s\"\n", trace->references + 1,
+		       (int) (available < 16 ? available : 16), (const char *) data);
+		return -1;
+	}
+	trace->offset += length;
+	*value = number;
+	return 1;
+}
+
+/*
+ * @brief - TraceAvailable - the number of bytes of the trace after the one at trace->offset that can be parsed
+ *
+ * If fewer than need are left in the buffer of a trace that is read, the rest of the buffer is moved to its start and
+ * more is read after it. The number returned is less than need only at the end of the trace.
+ */
+size_t TraceAvailable(struct_trace_reader *trace, size_t need)
+{
+	ssize_t got;
+
+	if (trace->length - trace->offset >= need || trace->buffer == NULL || trace->end)
+		return trace->length - trace->offset;
+	memmove(trace->buffer, trace->buffer + trace->offset, trace->length - trace->offset);
+	trace->length -= trace->offset;
+	trace->offset = 0;
+	while (trace->length < need && !trace->end)
+	{
+		got = read(trace->fd, trace->buffer + trace->length, TRACE_BUFFER_BYTES - trace->length);
+		if (got > 0)
+			trace->length += got;
+		else if (got == 0)
+			trace->end = 1;
+		else if (errno != EINTR)
+		{
+			printf("Cannot read the trace: %s\n", strerror(errno));
+			trace->end = trace->failed = 1;
+		}
+	}
+	return trace->length - trace->offset;
+}
+
+/*
+ * @brief - TraceRelease - gives back the pages of a mapped trace that have been parsed, every TRACE_RELEASE_BYTES, so
+ *			that a trace larger than the memory does not push everything else out of it
+ */
+void TraceRelease(struct_trace_reader *trace)
+{
+	size_t end = trace->offset & ~((size_t) sysconf(_SC_PAGESIZE) - 1);
+
+	if (trace->mapped > 0 && end - trace->released >= TRACE_RELEASE_BYTES)
+	{
+		madvise((char *) trace->data + trace->released, end - trace->released, MADV_DONTNEED);
+		trace->released = end;
+	}
+}
+
+/*
+ * @brief - TraceShare - makes a cursor that reads a mapped, or built-in, trace from its start without copying it
+ *
+ * Inputs: *trace - a trace opened with TraceOpen that has no buffer, from which nothing needs to have been read
+ *
+ * Any number of cursors can read the same trace at once, each in its own thread, as none of them writes to it. Each
+ * gives back the pages it has parsed as the trace does, and another cursor that has not reached them yet reads them
+ * again from the file. Closing a cursor with TraceClose leaves the trace open.
+ */
+void TraceShare(const struct_trace_reader *trace, struct_trace_reader *cursor)
+{
+	*cursor = *trace;
+	cursor->fd = -1;
+	cursor->offset = cursor->released = 0;
+	cursor->references = 0;
+	cursor->shared = 1;
+}
+
+/* ************************ End of Methods and functions for reading reference traces **************************** */
+
+int isNumber(char number[]) //checks if the number is a positive integer
+{
+	int numIndex = 0;
+	//checking for negative numbers
+	if (number[0] == '-')
+		return 1;
+	while (number[numIndex] != 0) //if greater or equal than one digit
+	{
+		if (!isdigit(number[numIndex])) //check if it is number
+			return 1; //if not return false
+		numIndex++;
+	}
+	return 0;
+}
+
+
+void *thread1_routine(struct_thread1_info * data)
+{
+	int count, print;
+
+	sem_wait(data->sem_pageReplacement); //wait for page replacement sem
+
+	if (data->batch != NULL) //every policy with every number of frames, on worker threads
+	{
+		if (runBatch(data->batch) != 0)
+			exit(1);
+		*data->count = data->batch->references;
+		printf("Ran %d pairs of a page replacement policy and a number of frames over %lld references on %d worker threads\n",
+		       data->batch->numOfRuns, *data->count, data->batch->workers);
+		sem_post(data->sem_signalHandler); /* relinquish access to signalhandler sem */
+		return NULL;
+	}
+	if (data->curve != NULL) //the faults with every number of frames
+	{
+		if (computeFaultCurve(data->trace, data->arr, data->curve) != 0)
+			exit(1);
+		*data->count = data->curve->references;
+		printf("Found the faults with every number of frames from 1 to %d over %lld references\n", data->frameSize,
+		       *data->count);
+		sem_post(data->sem_signalHandler); /* relinquish access to signalhandler sem */
+		return NULL;
+	}
+	if (data->numOfPolicies > 0) //compare the policies instead of printing the FIFO frames
+	{
+		if (compareReplacementPolicies(data->trace, data->arr, data->frameSize, data->policies, data->numOfPolicies,
+		                               data->results) != 0)
+			exit(1);
+		*data->count = data->trace->references;
+		printf("Ran %d page replacement policies over %lld references with %d frames\n", data->numOfPolicies,
+		       *data->count, data->frameSize);
+		sem_post(data->sem_signalHandler); /* relinquish access to signalhandler sem */
+		return NULL;
+	}
+	createFrameList(data->frameSize); //create the frame with NULL values
+	if ((count = TraceRead(data->trace, data->arr, TRACE_CHUNK)) < 0) //read the first chunk of the reference string
+		exit(1);
+	print = count < TRACE_CHUNK && count <= PRINT_REFERENCE_LIMIT && data->frameSize <= PRINT_FRAME_LIMIT; //only small runs are printed
+	if (PageIndexInit(&pageIndex, data->frameSize, data->arr, count) != 0) //create the index of the frames
+	{
+		perror("malloc");
+		exit(1);
+	}
+	printFifoHeader(print);
+	while (count > 0)
+	{
+		fifo(count, data->arr, data->faults, print); //run the FIFO
+		*data->count += count;
+		if ((count = TraceRead(data->trace, data->arr, TRACE_CHUNK)) < 0)
+			exit(1);
+	}
+	PageIndexFree(&pageIndex);
+	puts("");
+
+	sem_post(data->sem_signalHandler); /* relinquish access to signalhandler sem */
+}
+
+void *thread2_routine(struct_thread2_info * data)
+{
+	sem_wait(data->sem_signalHandler); //waits for access to signal handler
+	printf("\n\nAwaiting ctrl+c signal to print total number of page faults...\n");
+
+	//waits until ctrl+c is pressed before executing the function
+	/* ***************************************** */
+	if (signal(SIGINT, sighandler) == SIG_ERR) //waits until ctrl+c signal is received - if SIG_ERR then print error
+		printf("\n cant catch SIGINT \n");
+	sleep(1); //to put less strain on the program - sleep for one second
+	while (flag != 1);
+
+	/* ***************************************** */
+	printf("\nSignal Received \n");
+	if (data->batch != NULL)
+		printBatchResults(data->batch);
+	else if (data->curve != NULL)
+		printFaultCurve(data->curve);
+	else if (data->numOfPolicies > 0)
+		printReplacementResults(data->policies, data->results, data->numOfPolicies);
+	else
+	{
+		printf("\n------------------------------------------------------------\n");
+		printf("             Total Number of Page faults: %lld", *data->faults);
+		printf("\n------------------------------------------------------------\n");
+	}
+	sem_post(data->sem_pageReplacement); /* relinquish access to page replacement sem */
+
+}
+
+int initialiseSemaphores(sem_t *sem_pageReplacement, sem_t *sem_signalHandler)
+{
+	if (sem_init(sem_pageReplacement, 0, 1) == -1 || sem_init(sem_signalHandler, 0, 0) == -1)
+	{
+		printf("sem_init failed: %s\n", strerror(errno));
+		return (-1);
+	}
+	return 0;
+}
+
+int main(int argc, char* argv [])
+{
+	long long count = 0;
+	int frameSize;
+	long long faults = 0;
+	int *arr; //a chunk of the reference string
+	const struct_replacement_policy *policies[REPLACEMENT_POLICY_LIMIT];
+	struct_replacement_stats results[REPLACEMENT_POLICY_LIMIT];
+	int numOfPolicies = 0, opt;
+	char *traceFile = NULL; //NULL for the built-in reference string
+	int traceFormat = TRACE_TEXT;
+	unsigned long long pageSize = 0; //0 until given with -s
+	char *end;
+	struct_trace_reader trace;
+	int curveFlag = 0; //1 - find the faults with every number of frames up to frameSize (-c)
+	struct_fault_curve curve, *curveResult = NULL;
+	char curvePolicies[] = "lru,fifo"; //the policies of the curve when -p is not given
+	int workers = -1; //number of worker threads of a batch (-w), -1 without -w
+	int *frameSizes = NULL; //numbers of frames of a batch
+	int numOfFrameSizes = 0, run;
+	struct_batch batch, *batchResult = NULL;
+	char batchPolicies[] = "fifo"; //the policies of a batch when -p is not given
+
+	sem_t sem_pageReplacement, sem_signalHandler; /* semaphore definitions */
+	pthread_t thread1, thread2;    /* pthread defintions */
+
+	instructions();
+
+	while ((opt = getopt(argc, argv, "p:f:b:s:cw:")) != -1)
+	{
+		switch (opt)
+		{
+		case 'p':
+			if ((numOfPolicies = parseReplacementPolicies(optarg, policies)) < 0)
+				return -1;
+			break;
+		case 'f':
+			traceFile = optarg;
+			break;
+		case 'b':
+			if (strcmp(optarg, "32") != 0 && strcmp(optarg, "64") != 0)
+			{
+				printf("-b takes the size of the addresses in a binary trace: 32 or 64\n");
+				return -1;
+			}
+			traceFormat = strcmp(optarg, "32") == 0 ? TRACE_BINARY32 : TRACE_BINARY64;
+			break;
+		case 's':
+			pageSize = strtoull(optarg, &end, 0);
+			if (*optarg == '-' || *end != 0 || pageSize == 0)
+			{
+				printf("-s takes the page size in bytes, more than 0\n");
+				return -1;
+			}
+			break;
+		case 'c':
+			curveFlag = 1;
+			break;
+		case 'w':
+			workers = (int) strtol(optarg, &end, 10);
+			if (!isdigit((unsigned char) *optarg) || *end != 0 || strlen(optarg) > 4 || workers > BATCH_WORKER_LIMIT)
+			{
+				printf("-w takes the number of worker threads, up to %d, or 0 for one for each processor\n",
+				       BATCH_WORKER_LIMIT);
+				return -1;
+			}
+			if (workers == 0 && (workers = (int) sysconf(_SC_NPROCESSORS_ONLN)) < 1)
+				workers = 1;
+			break;
+		default:
+			printf("usage: ./Prg_2 [-p policy[,policy...]|all] [-c] [-w workers] [-f trace|-] [-b 32|64] [-s page size] "
+			       "frames\n       frames can be a list such as 4,8,16-32 with -w\n");
+			return -1;
+		}
+	}
+	if (traceFormat != TRACE_TEXT && traceFile == NULL)
+	{
+		printf("-b reads a binary trace, which has to be given with -f\n");
+		return -1;
+	}
+	if (pageSize == 0) //addresses in a binary trace, page numbers in a text one
+		pageSize = traceFormat == TRACE_TEXT ? 1 : TRACE_DEFAULT_PAGE_SIZE;
+	if (argc - optind != 1)
+	{
+		printf("Incorrect number of arguments placed in command line.\n");
+		printf("Please place only one integer to the command line when executing.\n");
+		return -1;
+	}
+	if (workers >= 0 && !curveFlag) //a batch of runs on worker threads - with -c the workers run the curve instead
+	{
+		if ((numOfFrameSizes = parseFrameSizes(argv[optind], &frameSizes)) < 0)
+			return -1;
+		if (numOfPolicies == 0)
+			numOfPolicies = parseReplacementPolicies(batchPolicies, policies);
+		batch.workers = workers;
+		batch.hashOnly = 0;
+		batch.numOfRuns = numOfPolicies * numOfFrameSizes;
+		batch.references = 0;
+		batch.policies = malloc(sizeof (const struct_replacement_policy *) * batch.numOfRuns);
+		batch.frameSizes = malloc(sizeof (int) * batch.numOfRuns);
+		batch.results = malloc(sizeof (struct_replacement_stats) * batch.numOfRuns);
+		if (batch.policies == NULL || batch.frameSizes == NULL || batch.results == NULL)
+		{
+			perror("malloc");
+			return -1;
+		}
+		for (run = 0; run < batch.numOfRuns; run++) //every number of frames of a policy together
+		{
+			batch.policies[run] = policies[run / numOfFrameSizes];
+			batch.frameSizes[run] = frameSizes[run % numOfFrameSizes];
+		}
+		batch.trace = &trace;
+		batchResult = &batch;
+		frameSize = frameSizes[numOfFrameSizes - 1];
+	}
+	else if (isNumber(argv[optind]) != 0 || atoi(argv[optind]) < 1)
+	{
+		printf("Incorrect input, try again\n");
+		return (-1);
+	}
+	else
+		frameSize = atoi(argv[optind]); //sets frame size to number given in command line
+	if (curveFlag)
+	{
+		if (numOfPolicies == 0)
+			numOfPolicies = parseReplacementPolicies(curvePolicies, policies);
+		for (opt = 0; opt < numOfPolicies; opt++)
+			if (policies[opt]->finish != NULL)
+			{
+				printf("-c cannot find the faults of %s, which would keep the trace for every number of frames\n",
+				       policies[opt]->name);
+				return -1;
+			}
+		curve.frames = frameSize;
+		curve.numOfPolicies = numOfPolicies;
+		curve.policies = policies;
+		curve.references = 0;
+		curve.workers = workers > 0 ? workers : 0;
+		if ((curve.faults = malloc(sizeof (long long) * numOfPolicies * frameSize)) == NULL)
+		{
+			perror("malloc");
+			return -1;
+		}
+		curveResult = &curve;
+	}
+	if (TraceOpen(&trace, traceFile, traceFormat, pageSize) != 0)
+		return -1;
+	if (workers >= 0 && trace.buffer != NULL)
+	{
+		printf("-w shares the trace between the worker threads, so it has to be a file that can be memory-mapped, "
+		       "not a pipe or an empty file\n");
+		TraceClose(&trace);
+		if (batchResult != NULL)
+		{
+			free(batch.policies);
+			free(batch.frameSizes);
+			free(batch.results);
+			free(frameSizes);
+		}
+		if (curveResult != NULL)
+			free(curve.faults);
+		return -1;
+	}
+	if ((arr = malloc(sizeof (int) * TRACE_CHUNK)) == NULL)
+	{
+		perror("malloc");
+		return -1;
+	}
+
+
+	initialiseSemaphores(&sem_pageReplacement, &sem_signalHandler); //initailise semaphores so that they can used in the threads
+
+	/* put values into structs so that they can be passed to the threads */
+	struct_thread1_info a = {&sem_pageReplacement, &sem_signalHandler, &count, arr, frameSize, &faults, &trace,
+	                         policies, numOfPolicies, results, curveResult, batchResult};
+	struct_thread2_info b = {&sem_signalHandler, &sem_pageReplacement, &faults, policies, numOfPolicies, results,
+	                         curveResult, batchResult};
+
+	//creates the pthreads - if not 0 then print error and exit program
+	if (pthread_create(&thread1, NULL, (void *)thread1_routine, &a) != 0 ||
+	        pthread_create(&thread2, NULL, (void *)thread2_routine, &b) != 0)
+	{
+		perror("pthread_create");
+		return (-1);
+	}
+
+	pthread_join(thread1, NULL); /* to identify if the thread-termination was completed */
+	pthread_join(thread2, NULL); //add error checking
+
+	TraceClose(&trace);
+	free(arr);
+	if (curveResult != NULL)
+		free(curve.faults);
+	if (batchResult != NULL)
+	{
+		free(batch.policies);
+		free(batch.frameSizes);
+		free(batch.results);
+		free(frameSizes);
+	}
 	return 0;
 }